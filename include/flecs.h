@@ -43,6 +43,21 @@
  * has caught up */
 #define FLECS_DEPRECATED
 
+/* FLECS_VM_ENTITY_INDEX reserves virtual memory for the entity index up front,
+ * for FLECS_VM_ENTITY_COUNT ids. Memory is committed by the OS as it is used,
+ * which removes the allocation of entity index chunks and an indirection from
+ * entity lookups. Requires the virtual memory functions of the OS API. If the
+ * reserved range does not fit in the address space, which is the case for the
+ * default count on 32 bit platforms, the regular entity index is used. */
+// #define FLECS_VM_ENTITY_INDEX
+
+/* FLECS_VM_HUGE_PAGES requests huge pages for the reserved entity index */
+// #define FLECS_VM_HUGE_PAGES
+
+#ifndef FLECS_VM_ENTITY_COUNT
+#define FLECS_VM_ENTITY_COUNT (1 << 28)
+#endif // FLECS_VM_ENTITY_COUNT
+
 /* Set to double or int to increase accuracy of time keeping. Note that when
  * using an integer type, an application has to provide the delta_time values
  * to the progress() function, as the code that measures time requires a
@@ -639,6 +654,18 @@ typedef struct ecs_world_info_t {
     int32_t systems_ran_frame;  /* Total number of systems ran in last frame */
 } ecs_world_info_t;
 
+/** Policy that determines how table storage grows when it is full. 
+ * Storage grows by factor until its size reaches linear_threshold, after which
+ * it grows by linear_step elements. If max_slack is set, storage never grows
+ * to more than max_slack elements beyond what is needed. Zero-initialized 
+ * members other than factor disable the corresponding behavior. */
+typedef struct ecs_growth_policy_t {
+    float factor;                /* Geometric growth factor (must be > 1) */
+    int32_t linear_threshold;    /* Size above which storage grows linearly */
+    int32_t linear_step;         /* Number of elements to grow by linearly */
+    int32_t max_slack;           /* Max number of unused elements after grow */
+} ecs_growth_policy_t;
+
 /** @} */
 
 /* Only include deprecated definitions if deprecated addon is required */
@@ -719,6 +746,17 @@ FLECS_API extern const ecs_entity_t EcsFinal;
  * when it or the relation object is a component. */
 FLECS_API extern const ecs_entity_t EcsTag;
 
+/* Can be added to a component or tag to store it in a sparse set instead of in
+ * the table of an entity. Adding or removing a sparse component does not move
+ * the entity to another table, which makes it a good fit for components that
+ * are frequently toggled. Queries can match sparse components with And, Not
+ * and Optional terms on This. Iterating a sparse component with data returns
+ * one entity at a time. Sparse components do not emit OnAdd/OnRemove/OnSet
+ * events. The tag must be added before the component is used. For example:
+ *   ecs_add_id(world, ecs_id(Stunned), EcsSparse);
+ */
+FLECS_API extern const ecs_entity_t EcsSparse;
+
 /* Used to express parent-child relations. */
 FLECS_API extern const ecs_entity_t EcsChildOf;
 
@@ -1146,6 +1184,65 @@ void ecs_dim(
     ecs_world_t *world,
     int32_t entity_count);
 
+/** Dimension a type for a specified number of entities.
+ * This operation will preallocate memory for a type (table) for the
+ * specified number of entities. Specifying a number lower than the current
+ * number of entities in the table will have no effect. The storage is sized
+ * exactly to the specified number of entities.
+ *
+ * @param world The world.
+ * @param type Handle to the type, as obtained by ecs_type_get.
+ * @param entity_count The number of entities to preallocate.
+ */
+FLECS_API
+void ecs_dim_type(
+    ecs_world_t *world,
+    ecs_type_t type,
+    int32_t entity_count);
+
+/** Set the default growth policy for table storage.
+ * The policy is used by all tables that don't have their own policy. By 
+ * default table storage doubles in size when it is full.
+ *
+ * @param world The world.
+ * @param policy The growth policy. If NULL, the default policy is restored.
+ */
+FLECS_API
+void ecs_set_growth_policy(
+    ecs_world_t *world,
+    const ecs_growth_policy_t *policy);
+
+/** Set the growth policy for the storage of a type (table).
+ * This overrides the world growth policy for the table of the type.
+ *
+ * @param world The world.
+ * @param type Handle to the type, as obtained by ecs_type_get.
+ * @param policy The growth policy. If NULL, the table uses the world policy.
+ */
+FLECS_API
+void ecs_set_type_growth_policy(
+    ecs_world_t *world,
+    ecs_type_t type,
+    const ecs_growth_policy_t *policy);
+
+/** Release memory that is no longer used by the world.
+ * Storage keeps its peak capacity when entities are deleted, so that it does
+ * not have to be reallocated when new entities are created. This operation
+ * shrinks table storage to the number of entities in each table, and releases
+ * memory of the entity index that is no longer used by alive entities.
+ *
+ * Ids of deleted entities that are larger than the largest alive entity id may
+ * no longer be recycled after calling this operation. Pointers to components
+ * obtained before calling this operation are no longer valid. This operation
+ * may not be called while the world is in readonly mode.
+ *
+ * @param world The world.
+ * @return The number of bytes released.
+ */
+FLECS_API
+int64_t ecs_compact(
+    ecs_world_t *world);
+
 /** Set a range for issueing new entity ids.
  * This function constrains the entity identifiers returned by ecs_new to the 
  * specified range. This operation can be used to ensure that multiple processes
@@ -1860,6 +1957,24 @@ void ecs_delete(
     ecs_world_t *world,
     ecs_entity_t entity);
 
+/** Delete multiple entities.
+ * This operation is equivalent to calling ecs_delete for each entity, but is 
+ * faster when deleting many entities. Entities are grouped by table, remove 
+ * actions are invoked once per range of consecutive rows, and each table is
+ * compacted in a single pass.
+ *
+ * Entities that are not alive are ignored.
+ *
+ * @param world The world.
+ * @param entities The entities to delete.
+ * @param count The number of entities.
+ */
+FLECS_API
+void ecs_delete_n(
+    ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count);
+
 
 /** Delete children of an entity.
  * This operation deletes all children of a parent entity. If a parent has no
@@ -1908,6 +2023,41 @@ const void* ecs_get_id(
 #define ecs_get(world, entity, component)\
     (ECS_CAST(const component*, ecs_get_id(world, entity, ecs_id(component))))
 
+/** Get immutable pointers to a component for an array of entities.
+ * This operation is equivalent to calling ecs_get_id for each entity, but is
+ * faster when getting a component for many entities. The component lookup is
+ * done once for all entities stored in the same table, and records & component
+ * data are prefetched, so that the cost of the cache misses is shared across 
+ * the entities in the array.
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param id The entity id of the component to obtain.
+ * @param ptrs Array with count elements that receives the component pointers.
+ *             An element is set to NULL if the entity does not have the 
+ *             component.
+ */
+FLECS_API
+void ecs_get_many_id(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t id,
+    const void **ptrs);
+
+/** Get immutable pointers to a component for an array of entities.
+ * Same as ecs_get_many_id, but accepts the typename of a component.
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param component The component to obtain.
+ * @param ptrs Array with count elements that receives the component pointers.
+ */
+#define ecs_get_many(world, entities, count, component, ptrs)\
+    ecs_get_many_id(world, entities, count, ecs_id(component), (const void**)(ptrs))
+
 /* -- Get cached pointer -- */
 
 /** Get an immutable reference to a component.
@@ -2087,6 +2237,45 @@ ecs_entity_t ecs_set_id(
 #define ecs_set_ptr(world, entity, component, ptr)\
     ecs_set_id(world, entity, ecs_id(component), sizeof(component), ptr)
 
+/** Set the value of a component for an array of entities.
+ * This operation is equivalent to calling ecs_set_id for each entity, but is
+ * faster when setting a component for many existing entities. Entities are
+ * grouped by table, and OnSet triggers and systems are invoked once for each 
+ * range of entities that is stored in consecutive rows of the same table.
+ *
+ * The entities must be alive. Entities that do not have the component yet will
+ * have it added. 
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param id The entity id of the component to set.
+ * @param size The size of the component.
+ * @param values Array with count values, in the same order as entities.
+ */
+FLECS_API
+void ecs_set_many_id(
+    ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t id,
+    size_t size,
+    const void *values);
+
+/** Set the value of a component for an array of entities.
+ * Same as ecs_set_many_id, but accepts a component typename and automatically
+ * determines the type size.
+ *
+ * @param world The world.
+ * @param entities The entities.
+ * @param count The number of entities.
+ * @param component The component to set.
+ * @param values Array with count values.
+ */
+#define ecs_set_many(world, entities, count, component, values)\
+    ecs_set_many_id(world, entities, count, ecs_id(component),\
+        sizeof(component), values)
+
 /* Conditionally skip macro's as compound literals and variadic arguments are 
  * not supported in C89 */
 #ifndef FLECS_LEGACY
@@ -3202,6 +3391,10 @@ bool ecs_query_next_w_filter(
  * threads. If there are less entities in a table than there are threads, only
  * as many threads as there are entities will iterate that table.
  *
+ * If the query has a CASCADE column and is iterated by the threads created by
+ * ecs_set_threads, tables of the same depth are iterated in parallel, and all
+ * threads wait for each other before moving on to the next depth.
+ *
  * @param it The iterator.
  * @param stage_current Id of current stage.
  * @param stage_count Total number of stages.
@@ -3655,6 +3848,26 @@ FLECS_API
 bool ecs_defer_end(
     ecs_world_t *world);
 
+/** Enable/disable coalescing of OnSet events for deferred operations.
+ * When coalescing is enabled, setting or modifying the same component on the
+ * same entity multiple times while deferred results in a single OnSet event
+ * when the operations are merged. Events are delivered after all deferred
+ * operations have been executed, and are batched for entities that are stored
+ * in consecutive rows of the same table. 
+ *
+ * Events are not delivered for entities that are deleted, or for components
+ * that are removed by a later deferred operation. Coalescing is disabled by
+ * default.
+ *
+ * @param world The world.
+ * @param enable True if coalescing should be enabled, false to disable.
+ * @return The previous value.
+ */
+FLECS_API
+bool ecs_enable_on_set_coalescing(
+    ecs_world_t *world,
+    bool enable);
+
 /** Enable/disable automerging for world or stage.
  * When automerging is enabled, staged data will automatically be merged with
  * the world when staging ends. This happens at the end of progress(), at a
@@ -29,7 +29,8 @@ typedef struct ecs_dbg_table_t {
     ecs_type_t container;
     ecs_type_t parent_entities;
     ecs_type_t base_entities;     
-    ecs_vector_t *systems_matched;
+    ecs_query_t **systems_matched;
+    int32_t systems_matched_count;
     ecs_entity_t *entities;
     int32_t entities_count;
 } ecs_dbg_table_t;
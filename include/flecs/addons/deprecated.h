@@ -205,13 +205,6 @@ extern "C" {
 
 typedef ecs_ids_t ecs_entities_t;
 
-ECS_DEPRECATED("deprecated functionality")
-FLECS_API
-void ecs_dim_type(
-    ecs_world_t *world,
-    ecs_type_t type,
-    int32_t entity_count);
-
 ECS_DEPRECATED("use ecs_new_w_id")
 FLECS_API
 ecs_entity_t ecs_new_w_type(
@@ -643,6 +643,24 @@ public:
     template <typename T>
     const T* get() const;
 
+    /** Get component for an array of entities.
+     * Pointers for entities that don't have the component are set to nullptr.
+     *
+     * @param entities The entities.
+     * @param count The number of entities.
+     * @param ptrs Array that receives the component pointers.
+     */
+    template <typename T>
+    void get_many(
+        const flecs::entity_t *entities, 
+        int32_t count, 
+        const T **ptrs) const 
+    {
+        ecs_get_many_id(m_world, entities, count, 
+            _::cpp_type<T>::id(m_world), 
+            reinterpret_cast<const void**>(ptrs));
+    }
+
     /** Test if world has singleton component.
      */
     template <typename T>
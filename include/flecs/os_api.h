@@ -87,6 +87,17 @@ typedef
 char* (*ecs_os_api_strdup_t)(
     const char *str);
 
+/* Virtual memory */
+typedef
+void* (*ecs_os_api_vm_reserve_t)(
+    size_t size,
+    bool huge_pages);
+
+typedef
+void (*ecs_os_api_vm_free_t)(
+    void *ptr,
+    size_t size);
+
 /* Threads */
 typedef
 void* (*ecs_os_thread_callback_t)(
@@ -248,6 +259,13 @@ typedef struct ecs_os_api_t {
     /* Overridable function that translates from a logical module id to a
      * path that contains module-specif resources or assets */
     ecs_os_api_module_to_path_t module_to_etc_;    
+
+    /* Virtual memory. Reserved memory is zero-initialized, and is committed
+     * by the OS when it is first written to. Reset discards the contents of
+     * a range, which makes it read as zero again. */
+    ecs_os_api_vm_reserve_t vm_reserve_;
+    ecs_os_api_vm_free_t vm_release_;
+    ecs_os_api_vm_free_t vm_reset_;
 } ecs_os_api_t;
 
 FLECS_API
@@ -330,6 +348,11 @@ void ecs_os_set_api_defaults(void);
 #endif
 #endif
 
+/* Virtual memory */
+#define ecs_os_vm_reserve(size, huge_pages) ecs_os_api.vm_reserve_(size, huge_pages)
+#define ecs_os_vm_release(ptr, size) ecs_os_api.vm_release_(ptr, size)
+#define ecs_os_vm_reset(ptr, size) ecs_os_api.vm_reset_(ptr, size)
+
 /* Threads */
 #define ecs_os_thread_new(callback, param) ecs_os_api.thread_new_(callback, param)
 #define ecs_os_thread_join(thread) ecs_os_api.thread_join_(thread)
@@ -410,6 +433,10 @@ void* ecs_os_memdup(
 FLECS_API
 bool ecs_os_has_heap(void);
 
+/** Are virtual memory functions available? */
+FLECS_API
+bool ecs_os_has_vm(void);
+
 /** Are threading functions available? */
 FLECS_API
 bool ecs_os_has_threading(void);
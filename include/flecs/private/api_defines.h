@@ -85,6 +85,13 @@ typedef int32_t ecs_size_t;
 #define ECS_UNUSED
 #endif
 
+/* Hint that memory will be read soon, so the load can overlap other work */
+#if defined(__GNUC__)
+#define ECS_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define ECS_PREFETCH(ptr) (void)(ptr)
+#endif
+
 #ifndef FLECS_NO_DEPRECATED_WARNINGS
 #if defined(__GNUC__)
 #define ECS_DEPRECATED(msg) __attribute__((deprecated(msg)))
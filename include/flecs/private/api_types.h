@@ -42,6 +42,9 @@ typedef struct ecs_sparse_t ecs_sparse_t;
 /* Switch list */
 typedef struct ecs_switch_t ecs_switch_t;
 
+/* Children of a parent */
+typedef struct ecs_parent_record_t ecs_parent_record_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Non-opaque types
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,8 +95,8 @@ typedef struct ecs_iter_table_t {
 /** Scope-iterator specific data */
 typedef struct ecs_scope_iter_t {
     ecs_filter_t filter;
-    ecs_map_iter_t tables;
-    int32_t index;
+    ecs_parent_record_t *parent;
+    uint64_t next_table_id;
     ecs_iter_table_t table;
 } ecs_scope_iter_t;
 
@@ -112,6 +115,10 @@ typedef struct ecs_query_iter_t {
     int32_t sparse_smallest;
     int32_t sparse_first;
     int32_t bitset_first;
+    int32_t sparse_storage_first;
+    int32_t sparse_storage_last;
+    ecs_id_t storage_id;
+    int32_t storage_match;
 } ecs_query_iter_t;  
 
 /** Query-iterator specific data */
@@ -4,6 +4,12 @@
  *
  * Datastructure that computes a hash to store & retrieve values. Similar to
  * ecs_map_t, but allows for arbitrary keytypes.
+ *
+ * Elements are stored in a single array of slots, where each slot contains
+ * the hash, key and value of an element. Collisions are resolved with linear
+ * probing. Because the hash is stored in the slot, keys only need to be
+ * compared when their hashes are equal. Removed elements leave a tombstone,
+ * which means that elements don't move until the map is rehashed.
  */
 
 #ifndef FLECS_HASHMAP_H
@@ -20,12 +26,11 @@ typedef struct {
     ecs_compare_action_t compare;
     ecs_size_t key_size;
     ecs_size_t value_size;
-    ecs_map_t *impl;
+    struct ecs_hm_slots_t *impl;
 } ecs_hashmap_t;
 
 typedef struct {
-    ecs_map_iter_t it;
-    struct ecs_hm_bucket_t *bucket;
+    const struct ecs_hm_slots_t *impl;
     int32_t index;
 } ecs_hashmap_iter_t;
 
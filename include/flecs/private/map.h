@@ -6,11 +6,17 @@
  * a 64-bit key. While it is not as fast as the sparse set, it is better at
  * handling randomly distributed values.
  *
- * Payload is stored in bucket arrays. A bucket is computed from an id by
- * using the (bucket_count - 1) as an AND-mask. The number of buckets is always
- * a power of 2. Multiple keys will be stored in the same bucket. As a result
- * the worst case retrieval performance of the map is O(n), though this is rare.
- * On average lookup performance should equal O(1).
+ * The map uses open addressing. Each slot stores the key and payload of an
+ * element inline, so a lookup only touches the slots it probes. The lower bits
+ * of a key select its preferred slot, so that sequential keys like entity and
+ * table ids are stored in consecutive slots. The upper bits of a key are mixed
+ * in, so that keys which only differ in their upper bits don't collide.
+ *
+ * Slots are kept ordered by the distance to their preferred slot (robin hood
+ * hashing). A lookup stops at the first element that is closer to its
+ * preferred slot than the key would be, which keeps lookups of missing keys
+ * short. Removing an element shifts back the elements after it that are not in
+ * their preferred slot.
  *
  * The datastructure will automatically grow the number of buckets when the
  * ratio between elements and buckets exceeds a certain threshold (LOAD_FACTOR).
@@ -38,10 +44,7 @@ typedef uint64_t ecs_map_key_t;
 
 typedef struct ecs_map_iter_t {
     const ecs_map_t *map;
-    struct ecs_bucket_t *bucket;
-    int32_t bucket_index;
-    int32_t element_index;
-    void *payload;
+    int32_t index;
 } ecs_map_iter_t;
 
 /** Create new map. */
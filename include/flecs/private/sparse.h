@@ -57,6 +57,17 @@ void ecs_sparse_set_id_source(
     ecs_sparse_t *sparse,
     uint64_t *id_source);
 
+/** Reserve virtual memory for indices [0 .. count). Chunks in the reserved
+ * range are not allocated, and lookups in the reserved range don't need to
+ * find the chunk. Must be called before elements are added. Returns false if
+ * the OS API has no virtual memory functions or the reservation failed, in
+ * which case the sparse set uses regular chunks. */
+FLECS_DBG_API
+bool ecs_sparse_reserve_vm(
+    ecs_sparse_t *sparse,
+    uint64_t count,
+    bool huge_pages);
+
 /** Free sparse set */
 FLECS_DBG_API
 void ecs_sparse_free(
@@ -67,6 +78,14 @@ FLECS_DBG_API
 void ecs_sparse_clear(
     ecs_sparse_t *sparse);
 
+/** Release memory that is no longer used by alive elements. Chunks after the
+ * chunk of the largest alive id are freed, and the dense array is shrunk.
+ * Removed ids in freed chunks will no longer be recycled, other removed ids
+ * are still recycled. Returns the number of bytes released. */
+FLECS_DBG_API
+int64_t ecs_sparse_compact(
+    ecs_sparse_t *sparse);
+
 /** Add element to sparse set, this generates or recycles an id */
 FLECS_DBG_API
 void* _ecs_sparse_add(
@@ -279,6 +279,9 @@ void _ecs_vector_reclaim(
 #define ecs_vector_reclaim(vector, T)\
     _ecs_vector_reclaim(vector, ECS_VECTOR_T(T))
 
+#define ecs_vector_reclaim_t(vector, size, alignment)\
+    _ecs_vector_reclaim(vector, ECS_VECTOR_U(size, alignment))
+
 /** Grow size of vector with provided number of elements. */
 FLECS_API
 int32_t _ecs_vector_grow(
@@ -304,6 +307,22 @@ int32_t _ecs_vector_set_size(
 #define ecs_vector_set_size_t(vector, size, alignment, elem_count) \
     _ecs_vector_set_size(vector, ECS_VECTOR_U(size, alignment), elem_count)
 
+/** Grow allocation size of vector to exactly the provided number of elements.
+ * Unlike ecs_vector_set_size, the size is not rounded up to a power of two.
+ * Does nothing if the vector is already large enough. */
+FLECS_API
+int32_t _ecs_vector_reserve(
+    ecs_vector_t **vector,
+    ecs_size_t elem_size,
+    int16_t offset,
+    int32_t elem_count);
+
+#define ecs_vector_reserve(vector, T, elem_count) \
+    _ecs_vector_reserve(vector, ECS_VECTOR_T(T), elem_count)
+
+#define ecs_vector_reserve_t(vector, size, alignment, elem_count) \
+    _ecs_vector_reserve(vector, ECS_VECTOR_U(size, alignment), elem_count)
+
 /** Set count of vector. If the size of the vector is smaller than the provided
  * count, the vector is resized. */
 FLECS_API
@@ -381,6 +400,74 @@ ecs_vector_t* _ecs_vector_copy(
 #define ecs_vector_copy_t(src, size, alignment) \
     _ecs_vector_copy(src, ECS_VECTOR_U(size, alignment))
 
+/* Number of bytes of inline storage in a small vector */
+#define ECS_SMALL_VECTOR_SIZE (32)
+
+/** Vector with inline storage for a small number of elements.
+ * Small vectors are embedded in other types instead of allocated. Elements are
+ * stored in the small vector itself until they no longer fit in
+ * ECS_SMALL_VECTOR_SIZE bytes, after which they are moved to the heap. This
+ * avoids allocations for internal vectors that usually hold a few elements.
+ *
+ * A zero-initialized small vector is empty. Element pointers are not stable,
+ * as they change when the small vector grows or is moved in memory. Elements
+ * may not have an alignment larger than 8 bytes. */
+typedef struct ecs_small_vector_t {
+    int32_t count;
+    int32_t size;               /* Heap capacity, 0 if elements are inline */
+    union {
+        void *ptr;
+        uint64_t inline_data[ECS_SMALL_VECTOR_SIZE / 8];
+    } data;
+} ecs_small_vector_t;
+
+/** Add element to small vector. */
+FLECS_DBG_API
+void* _ecs_small_vector_add(
+    ecs_small_vector_t *vector,
+    ecs_size_t elem_size);
+
+#define ecs_small_vector_add(vector, T) \
+    ((T*)_ecs_small_vector_add(vector, ECS_SIZEOF(T)))
+
+/** Remove element at index, last element is copied to the removed element. */
+FLECS_DBG_API
+void _ecs_small_vector_remove(
+    ecs_small_vector_t *vector,
+    ecs_size_t elem_size,
+    int32_t index);
+
+#define ecs_small_vector_remove(vector, T, index) \
+    _ecs_small_vector_remove(vector, ECS_SIZEOF(T), index)
+
+/** Get pointer to first element. Returns NULL if the vector is empty. */
+FLECS_DBG_API
+void* ecs_small_vector_first(
+    const ecs_small_vector_t *vector);
+
+#define ecs_small_vector_first_t(vector, T) \
+    ((T*)ecs_small_vector_first(vector))
+
+/** Get pointer to element at index. Returns NULL if out of bounds. */
+FLECS_DBG_API
+void* _ecs_small_vector_get(
+    const ecs_small_vector_t *vector,
+    ecs_size_t elem_size,
+    int32_t index);
+
+#define ecs_small_vector_get(vector, T, index) \
+    ((T*)_ecs_small_vector_get(vector, ECS_SIZEOF(T), index))
+
+/** Free heap storage of small vector and reset it to empty. */
+FLECS_DBG_API
+void ecs_small_vector_free(
+    ecs_small_vector_t *vector);
+
+/** Return number of elements in small vector. */
+FLECS_DBG_API
+int32_t ecs_small_vector_count(
+    const ecs_small_vector_t *vector);
+
 #ifndef FLECS_LEGACY
 #define ecs_vector_each(vector, T, var, ...)\
     {\
@@ -391,6 +478,16 @@ ecs_vector_t* _ecs_vector_copy(
             __VA_ARGS__\
         }\
     }
+
+#define ecs_small_vector_each(vector, T, var, ...)\
+    {\
+        int var##_i, var##_count = ecs_small_vector_count(vector);\
+        T* var##_array = ecs_small_vector_first_t(vector, T);\
+        for (var##_i = 0; var##_i < var##_count; var##_i ++) {\
+            T* var = &var##_array[var##_i];\
+            __VA_ARGS__\
+        }\
+    }
 #endif
 #ifdef __cplusplus
 }
@@ -24,7 +24,9 @@ void ecs_dbg_table(
     *dbg_out = (ecs_dbg_table_t){.table = table};
 
     dbg_out->type = table->type;
-    dbg_out->systems_matched = table->queries;
+    dbg_out->systems_matched = ecs_small_vector_first_t(
+        &table->queries, ecs_query_t*);
+    dbg_out->systems_matched_count = ecs_small_vector_count(&table->queries);
 
     /* Determine components from parent/base entities */
     ecs_entity_t *entities = ecs_vector_first(table->type, ecs_entity_t);
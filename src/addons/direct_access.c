@@ -174,6 +174,8 @@ void ecs_table_set_entities(
         ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
     }
 
+    ecs_table_update_parents(table, ecs_vector_count(entities));
+
     data->entities = entities;
     data->record_ptrs = records;
 }
@@ -181,7 +181,7 @@ void ecs_get_world_stats(
         /* If this table matches with queries and is not empty, increase the
          * matched table & matched entity count. These statistics can be used to
          * compute actual fragmentation ratio for queries. */
-        int32_t queries_matched = ecs_vector_count(table->queries);
+        int32_t queries_matched = ecs_small_vector_count(&table->queries);
         if (queries_matched && entity_count) {
             matched_table_count ++;
             matched_entity_count += entity_count;
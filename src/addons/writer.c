@@ -129,6 +129,8 @@ void ecs_table_writer_finalize_table(
             }
         }
     }
+
+    ecs_name_index_touch_table(world, writer->table, data);
 }
 
 static
@@ -157,6 +159,8 @@ void ecs_table_writer_prepare_column(
         writer->column_vector = column->data;
         writer->column_size = ecs_to_i16(size);
     } else {
+        ecs_table_update_parents(writer->table, writer->row_count);
+
         ecs_vector_set_count(
             &data->entities, ecs_entity_t, writer->row_count);
 
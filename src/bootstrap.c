@@ -71,7 +71,9 @@ static ECS_CTOR(EcsTrigger, ptr, {
 })
 
 static ECS_DTOR(EcsTrigger, ptr, {
-    ecs_trigger_fini(world, (ecs_trigger_t*)ptr->trigger);
+    if (ptr->trigger) {
+        ecs_trigger_fini(world, (ecs_trigger_t*)ptr->trigger);
+    }
 })
 
 static ECS_COPY(EcsTrigger, dst, src, {
@@ -139,6 +141,14 @@ void register_on_delete_object(ecs_iter_t *it) {
     }    
 }
 
+static
+void register_sparse(ecs_iter_t *it) {
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_sparse_storage_init(it->world, it->entities[i]);
+    }
+}
+
 static
 void on_set_component_lifecycle( ecs_iter_t *it) {
     EcsComponentLifecycle *cl = ecs_term(it, EcsComponentLifecycle, 1);
@@ -191,6 +201,8 @@ void _bootstrap_component(
     id_data[index].value = &id[ecs_os_strlen("Ecs")]; /* Skip prefix */
     id_data[index].symbol = ecs_os_strdup(id);
     id_data[index].alloc_value = NULL;
+
+    ecs_name_index_touch(world, entity);
 }
 
 /** Create type for component */
@@ -348,6 +360,7 @@ void ecs_bootstrap(
     bootstrap_entity(world, EcsTransitive, "Transitive", EcsFlecsCore);
     bootstrap_entity(world, EcsFinal, "Final", EcsFlecsCore);
     bootstrap_entity(world, EcsTag, "Tag", EcsFlecsCore);
+    bootstrap_entity(world, EcsSparse, "Sparse", EcsFlecsCore);
 
     bootstrap_entity(world, EcsOnDelete, "OnDelete", EcsFlecsCore);
     bootstrap_entity(world, EcsOnDeleteObject, "OnDeleteObject", EcsFlecsCore);
@@ -374,6 +387,7 @@ void ecs_bootstrap(
     ecs_add_id(world, EcsIsA, EcsFinal);
     ecs_add_id(world, EcsOnDelete, EcsFinal);
     ecs_add_id(world, EcsOnDeleteObject, EcsFinal);
+    ecs_add_id(world, EcsSparse, EcsFinal);
 
 
     /* Define triggers for when relationship cleanup rules are assigned */
@@ -389,6 +403,13 @@ void ecs_bootstrap(
         .events = {EcsOnAdd}
     });
 
+    /* Define trigger for when a component is marked for sparse storage */
+    ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term = {.id = EcsSparse},
+        .callback = register_sparse,
+        .events = {EcsOnAdd}
+    });
+
 
     /* Define trigger for when component lifecycle is set for component */
     ecs_trigger_init(world, &(ecs_trigger_desc_t){
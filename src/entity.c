@@ -58,7 +58,8 @@ void* get_base_component(
     ecs_id_t id,
     ecs_map_t *table_index,
     ecs_map_t *table_index_isa,
-    int32_t recur_depth)
+    int32_t recur_depth,
+    ecs_base_cache_elem_t *out)
 {
     /* Cycle detected in IsA relation */
     ecs_assert(recur_depth < ECS_MAX_RECURSION, ECS_INVALID_PARAMETER, NULL);
@@ -89,10 +90,11 @@ void* get_base_component(
 
     ecs_type_t type = table->type;
     ecs_id_t *ids = ecs_vector_first(type, ecs_id_t);
-    int32_t i = tr_isa->column, count = tr_isa->count;
+    int32_t i = tr_isa->column, end = i + tr_isa->count;
     void *ptr = NULL;
 
-    do {
+    /* IsA pairs are stored next to each other in the type */
+    for (; !ptr && (i < end); i ++) {
         ecs_id_t pair = ids[i];
 
         ecs_entity_t base = ecs_pair_object(world, pair);
@@ -110,18 +112,90 @@ void* get_base_component(
             ecs_table_record_t, table->id);
         if (!tr) {
             ptr = get_base_component(world, table, id, table_index, 
-                table_index_isa, recur_depth + 1);
+                table_index_isa, recur_depth + 1, out);
         } else {
             bool is_monitored;
             int32_t row = ecs_record_to_row(r->row, &is_monitored);
             ptr = get_component_w_index(table, tr->column, row);
+
+            out->base = base;
+            out->table = table;
+            out->column = tr->column;
         }
-        i ++;
-    } while (!ptr && (i < count));
+    }
 
     return ptr;
 }
 
+/* Same as get_base_component, but first look in the cache of the table. The
+ * cache is invalidated when the world base version changes, which happens when
+ * a watched entity (which includes all bases) changes its components. */
+static
+void* get_cached_base_component(
+    const ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_id_t id,
+    ecs_map_t *table_index)
+{
+    if (!(table->flags & EcsTableHasBase)) {
+        return NULL;
+    }
+
+    bool is_valid = table->base_version == world->base_version;
+    if (is_valid) {
+        ecs_base_cache_elem_t *elem = ecs_map_get(
+            table->base_cache, ecs_base_cache_elem_t, id);
+        if (elem) {
+            if (!elem->base) {
+                return NULL;
+            }
+
+            /* The base may have moved to another row, but if it moved to a
+             * different table the cached column is no longer valid */
+            ecs_record_t *r = ecs_eis_get(world, elem->base);
+            if (r && r->table == elem->table) {
+                bool is_monitored;
+                int32_t row = ecs_record_to_row(r->row, &is_monitored);
+                return get_component_w_index(elem->table, elem->column, row);
+            }
+        }
+    }
+
+    ecs_base_cache_elem_t elem = {0};
+    void *ptr = get_base_component(
+        world, table, id, table_index, NULL, 0, &elem);
+
+    /* Only populate the cache when no other threads can be reading it */
+    if (!world->is_readonly || ecs_get_stage_count(world) <= 1) {
+        if (!is_valid && table->base_cache) {
+            ecs_map_clear(table->base_cache);
+        }
+
+        table->base_version = world->base_version;
+
+        if (!table->base_cache) {
+            table->base_cache = ecs_map_new(ecs_base_cache_elem_t, 1);
+        }
+
+        ecs_map_set(table->base_cache, id, &elem);
+    }
+
+    return ptr;
+}
+
+void* ecs_get_base_component(
+    const ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_id_t id)
+{
+    ecs_id_record_t *idr = ecs_get_id_record(world, id);
+    if (!idr) {
+        return NULL;
+    }
+
+    return get_cached_base_component(world, table, id, idr->table_index);
+}
+
 /* Utility to compute actual row from row in record */
 static
 int32_t set_row_info(
@@ -253,8 +327,7 @@ void run_set_systems_for_entities(
     if (set_all) {
         /* Run OnSet systems for all components of the entity. This usually
          * happens when an entity is created directly in its target table. */
-        ecs_vector_t *queries = table->on_set_all;
-        ecs_vector_each(queries, ecs_matched_query_t, m, {
+        ecs_small_vector_each(&table->on_set_all, ecs_matched_query_t, m, {
             ecs_run_monitor(world, m, components, row, count, entities);
         });
     } else {
@@ -270,7 +343,7 @@ void run_set_systems_for_entities(
          * can happen in the case of instancing, where adding an IsA
          * relationship conceptually adds components to an entity, but the 
          * actual components are stored on the base entity. */
-        ecs_vector_t **on_set_systems = table->on_set;
+        ecs_small_vector_t *on_set_systems = table->on_set;
         if (on_set_systems) {
             int32_t index = ecs_type_index_of(table->type, components->array[0]);
             
@@ -279,8 +352,8 @@ void run_set_systems_for_entities(
              * function was invoked. */
             ecs_assert(index != -1, ECS_INTERNAL_ERROR, NULL);
 
-            ecs_vector_t *queries = on_set_systems[index];
-            ecs_vector_each(queries, ecs_matched_query_t, m, {
+            ecs_small_vector_t *queries = &on_set_systems[index];
+            ecs_small_vector_each(queries, ecs_matched_query_t, m, {
                 ecs_run_monitor(world, m, components, row, count, entities);
             });
         }
@@ -360,10 +433,10 @@ void ecs_run_set_systems(
 void ecs_run_monitors(
     ecs_world_t * world, 
     ecs_table_t * dst_table,
-    ecs_vector_t * v_dst_monitors, 
+    ecs_small_vector_t * v_dst_monitors, 
     int32_t dst_row, 
     int32_t count, 
-    ecs_vector_t *v_src_monitors)
+    ecs_small_vector_t *v_src_monitors)
 {
     (void)world;
     (void)dst_table;
@@ -377,23 +450,25 @@ void ecs_run_monitors(
         return;
     }
 
-    if (!v_dst_monitors) {
+    if (!ecs_small_vector_count(v_dst_monitors)) {
         return;
     }
 
     ecs_assert(!(dst_table->flags & EcsTableIsPrefab), ECS_INTERNAL_ERROR, NULL);
     
-    if (!v_src_monitors) {
-        ecs_vector_each(v_dst_monitors, ecs_matched_query_t, monitor, {
+    if (!ecs_small_vector_count(v_src_monitors)) {
+        ecs_small_vector_each(v_dst_monitors, ecs_matched_query_t, monitor, {
             ecs_run_monitor(world, monitor, NULL, dst_row, count, NULL);
         });
     } else {
         /* If both tables have monitors, run the ones that dst_table has and
          * src_table doesn't have */
-        int32_t i, m_count = ecs_vector_count(v_dst_monitors);
-        int32_t j = 0, src_count = ecs_vector_count(v_src_monitors);
-        ecs_matched_query_t *dst_monitors = ecs_vector_first(v_dst_monitors, ecs_matched_query_t);
-        ecs_matched_query_t *src_monitors = ecs_vector_first(v_src_monitors, ecs_matched_query_t);
+        int32_t i, m_count = ecs_small_vector_count(v_dst_monitors);
+        int32_t j = 0, src_count = ecs_small_vector_count(v_src_monitors);
+        ecs_matched_query_t *dst_monitors = ecs_small_vector_first_t(
+            v_dst_monitors, ecs_matched_query_t);
+        ecs_matched_query_t *src_monitors = ecs_small_vector_first_t(
+            v_src_monitors, ecs_matched_query_t);
 
         for (i = 0; i < m_count; i ++) {
             ecs_matched_query_t *dst = &dst_monitors[i];
@@ -503,6 +578,27 @@ void instantiate_children(
     /* Instantiate the prefab child table for each new instance */
     ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
     int32_t child_count = ecs_vector_count(child_data->entities);
+    ecs_entity_t *children = ecs_vector_first(
+        child_data->entities, ecs_entity_t);
+
+    /* Find out once which prefab children are parents themselves, so that
+     * instances only recurse for the children that have something to
+     * instantiate. For leaf children this avoids an id record lookup per
+     * child, per instance. */
+    bool child_is_parent_buffer[ECS_MAX_CHILD_BUFFER];
+    bool *child_is_parent = child_is_parent_buffer;
+    if (child_count > ECS_MAX_CHILD_BUFFER) {
+        child_is_parent = ecs_os_malloc(ECS_SIZEOF(bool) * child_count);
+    }
+
+    bool has_parents = false;
+    int j;
+    for (j = 0; j < child_count; j ++) {
+        const ecs_id_record_t *r = ecs_get_id_record(
+            world, ecs_pair(EcsChildOf, children[j]));
+        child_is_parent[j] = r && ecs_map_count(r->table_index);
+        has_parents |= child_is_parent[j];
+    }
 
     for (i = row; i < count + row; i ++) {
         ecs_entity_t instance = entities[i];
@@ -517,10 +613,8 @@ void instantiate_children(
         /* The instance is trying to instantiate from a base that is also
          * its parent. This would cause the hierarchy to instantiate itself
          * which would cause infinite recursion. */
-        int j;
-        ecs_entity_t *children = ecs_vector_first(
-            child_data->entities, ecs_entity_t);
 #ifndef NDEBUG
+        children = ecs_vector_first(child_data->entities, ecs_entity_t);
         for (j = 0; j < child_count; j ++) {
             ecs_entity_t child = children[j];        
             ecs_assert(child != instance, ECS_INVALID_PARAMETER, NULL);
@@ -531,13 +625,28 @@ void instantiate_children(
         int32_t child_row; 
         new_w_data(world, i_table, NULL, child_count, c_info, &child_row);       
 
-        /* If prefab child table has children itself, recursively instantiate */
+        if (!has_parents) {
+            continue;
+        }
+
+        /* If prefab child table has children itself, recursively instantiate.
+         * Instantiating can reallocate the entity array of the prefab child
+         * table, so get the array again for each child. */
         ecs_data_t *i_data = ecs_table_get_data(i_table);
         for (j = 0; j < child_count; j ++) {
+            if (!child_is_parent[j]) {
+                continue;
+            }
+
+            children = ecs_vector_first(child_data->entities, ecs_entity_t);
             ecs_entity_t child = children[j];
             instantiate(world, child, i_table, i_data, child_row + j, 1);
         }
-    }       
+    }
+
+    if (child_is_parent != child_is_parent_buffer) {
+        ecs_os_free(child_is_parent);
+    }
 }
 
 static
@@ -611,15 +720,24 @@ bool override_from_base(
 
             void *ctx = cdata->lifecycle.ctx;
             for (index = 0; index < count; index ++) {
-                copy(world, component, &entities[row], &base,
+                copy(world, component, &entities[row + index], &base,
                     data_ptr, base_ptr, ecs_to_size_t(data_size), 1, ctx);
                 data_ptr = ECS_OFFSET(data_ptr, data_size);
             }
         } else {
-            for (index = 0; index < count; index ++) {
-                ecs_os_memcpy(data_ptr, base_ptr, data_size);
-                data_ptr = ECS_OFFSET(data_ptr, data_size);
-            }                    
+            /* Copy the base value into the first instance, then replicate the
+             * initialized part of the column, doubling the size of each copy.
+             * This keeps the number of memcpy calls logarithmic in count. */
+            ecs_os_memcpy(data_ptr, base_ptr, data_size);
+            for (index = 1; index < count; index *= 2) {
+                int32_t to_copy = count - index;
+                if (to_copy > index) {
+                    to_copy = index;
+                }
+
+                ecs_os_memcpy(ECS_OFFSET(data_ptr, data_size * index), 
+                    data_ptr, data_size * to_copy);
+            }
         }
 
         return true;
@@ -741,8 +859,8 @@ void ecs_components_override(
     /* Run OnSet actions when a base entity is added to the entity for 
      * components not overridden by the entity. */
     if (run_on_set && table_without_base != table) {
-        ecs_run_monitors(world, table, table->on_set_all, row, count, 
-            table_without_base->on_set_all);
+        ecs_run_monitors(world, table, &table->on_set_all, row, count, 
+            &table_without_base->on_set_all);
     }
 }
 
@@ -890,7 +1008,7 @@ int32_t new_entity(
 
         if (new_table->flags & EcsTableHasMonitors) {
             ecs_run_monitors(
-                world, new_table, new_table->monitors, new_row, 1, NULL);              
+                world, new_table, &new_table->monitors, new_row, 1, NULL);              
         }        
     }
 
@@ -940,8 +1058,8 @@ int32_t move_entity(
         if (removed && (src_table->flags & EcsTableHasRemoveActions)) {
             /* If entity was moved, invoke UnSet monitors for each component that
              * the entity no longer has */
-            ecs_run_monitors(world, dst_table, src_table->un_set_all, 
-                src_row, 1, dst_table->un_set_all);
+            ecs_run_monitors(world, dst_table, &src_table->un_set_all, 
+                src_row, 1, &dst_table->un_set_all);
 
             ecs_run_remove_actions(
                 world, src_table, src_data, src_row, 1, removed);
@@ -962,16 +1080,16 @@ int32_t move_entity(
 
         /* Run monitors */
         if (dst_table->flags & EcsTableHasMonitors) {
-            ecs_run_monitors(world, dst_table, dst_table->monitors, dst_row, 
-                1, src_table->monitors);
+            ecs_run_monitors(world, dst_table, &dst_table->monitors, dst_row, 
+                1, &src_table->monitors);
         }
 
         /* If removed components were overrides, run OnSet systems for those, as 
          * the value of those components changed from the removed component to 
          * the value of component on the base entity */
         if (removed && dst_table->flags & EcsTableHasBase) {
-            ecs_run_monitors(world, dst_table, src_table->on_set_override, 
-                dst_row, 1, dst_table->on_set_override);          
+            ecs_run_monitors(world, dst_table, &src_table->on_set_override, 
+                dst_row, 1, &dst_table->on_set_override);          
         }
     }
 
@@ -989,7 +1107,7 @@ void delete_entity(
     ecs_ids_t * removed)
 {
     if (removed) {
-        ecs_run_monitors(world, src_table, src_table->un_set_all, 
+        ecs_run_monitors(world, src_table, &src_table->un_set_all, 
             src_row, 1, NULL);
 
         /* Invoke remove actions before deleting */
@@ -1048,7 +1166,7 @@ void update_component_monitor_w_array(
             update_component_monitor_w_array(
                 world, entity, relation, &base_entities);               
         } else {
-            ecs_monitor_mark_dirty(world, relation, id);
+            ecs_monitor_mark_dirty(world, entity, relation, id);
         }
     }
 }
@@ -1062,6 +1180,77 @@ void update_component_monitors(
 {
     update_component_monitor_w_array(world, entity, 0, added);
     update_component_monitor_w_array(world, entity, 0, removed);
+
+    /* Components that tables resolved from bases may have changed */
+    world->base_version ++;
+}
+
+static
+bool has_childof(
+    const ecs_ids_t *ids)
+{
+    if (!ids) {
+        return false;
+    }
+
+    int32_t i;
+    for (i = 0; i < ids->count; i ++) {
+        if (ECS_HAS_RELATION(ids->array[i], EcsChildOf)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Test if entity has any ids that are not stored in tables */
+static
+bool has_sparse_ids(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_vector_t *sparse_ids = world->store.sparse_ids;
+    if (!sparse_ids) {
+        return false;
+    }
+
+    ecs_id_t *ids = ecs_vector_first(sparse_ids, ecs_id_t);
+    int32_t i, count = ecs_vector_count(sparse_ids);
+    for (i = 0; i < count; i ++) {
+        ecs_sparse_t *storage = ecs_sparse_storage_get(world, ids[i]);
+        ecs_assert(storage != NULL, ECS_INTERNAL_ERROR, NULL);
+        if (ecs_sparse_storage_get_ptr(storage, entity)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Entities that only have ids which are not stored in tables are stored in the
+ * root table, so that queries can find them. Move the entity in or out of the
+ * root table after ids were added to or removed from sparse storage. */
+static
+void sparse_update_table(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_entity_info_t info;
+    ecs_get_info(world, entity, &info);
+
+    ecs_table_t *root = &world->store.root;
+    if (!info.table) {
+        if (has_sparse_ids(world, entity)) {
+            new_entity(world, entity, &info, root, &(ecs_ids_t){0}, false);
+        }
+    } else if (info.table == root) {
+        if (!has_sparse_ids(world, entity)) {
+            delete_entity(world, root, info.data, info.row, NULL);
+            ecs_eis_set(world, entity, &(ecs_record_t){
+                NULL, (info.is_watched == true) * -1
+            });
+        }
+    }
 }
 
 static
@@ -1095,10 +1284,16 @@ void commit(
         ecs_data_t *src_data = info->data;
         ecs_assert(dst_table != NULL, ECS_INTERNAL_ERROR, NULL);
 
-        if (dst_table->type) { 
+        if (dst_table->type || has_sparse_ids(world, entity)) { 
             info->row = move_entity(world, entity, info, src_table, 
                 src_data, info->row, dst_table, added, removed, construct);
             info->table = dst_table;
+
+            if (world->name_index_active && (
+                has_childof(added) || has_childof(removed))) 
+            {
+                ecs_name_index_touch(world, entity);
+            }
         } else {
             delete_entity(world, src_table, src_data, info->row, removed);
 
@@ -1226,12 +1421,21 @@ const ecs_entity_t* new_w_data(
             } else {
                 ecs_os_memcpy(ptr, src_ptr, size * count);
             }
+
+            if (c == ecs_id(EcsName)) {
+                ecs_entity_t *entities = ecs_vector_first(
+                    data->entities, ecs_entity_t);
+                int32_t i_e;
+                for (i_e = 0; i_e < count; i_e ++) {
+                    ecs_name_index_touch(world, entities[row + i_e]);
+                }
+            }
         };
 
         ecs_run_set_systems(world, &added, table, data, row, count, true);        
     }
 
-    ecs_run_monitors(world, table, table->monitors, row, count, NULL);
+    ecs_run_monitors(world, table, &table->monitors, row, count, NULL);
 
     ecs_defer_flush(world, &world->stage);
 
@@ -1263,9 +1467,44 @@ bool has_type(
     }
 
     ecs_type_t entity_type = ecs_get_type(world, entity);
+    const ecs_world_t *real_world = ecs_get_world(world);
+
+    if (!real_world->store.sparse_ids) {
+        return ecs_type_contains(
+            world, entity_type, type, match_any, match_prefabs) != 0;
+    }
+
+    /* Ids with sparse storage are not part of the entity type, so test ids one
+     * by one if the type has any */
+    ecs_id_t *ids = ecs_vector_first(type, ecs_id_t);
+    int32_t i, count = ecs_vector_count(type);
+    for (i = 0; i < count; i ++) {
+        if (ecs_sparse_storage_get(real_world, ids[i])) {
+            break;
+        }
+    }
+
+    if (i == count) {
+        return ecs_type_contains(
+            world, entity_type, type, match_any, match_prefabs) != 0;
+    }
+
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = ids[i];
+        bool has;
+
+        if (ecs_sparse_storage_get(real_world, id)) {
+            has = ecs_has_id(world, entity, id);
+        } else {
+            has = ecs_type_owns_id(world, entity_type, id, !match_prefabs);
+        }
+
+        if (has == match_any) {
+            return match_any;
+        }
+    }
 
-    return ecs_type_contains(
-        world, entity_type, type, match_any, match_prefabs) != 0;
+    return !match_any;
 }
 
 static
@@ -1336,6 +1575,74 @@ void remove_ids_w_info(
     commit(world, entity, info, dst_table, NULL, &removed, true);
 }
 
+/* Get or add an id that is not stored in tables */
+static
+void* ensure_sparse(
+    ecs_world_t *world,
+    ecs_sparse_t *storage,
+    ecs_id_t id,
+    ecs_entity_t entity,
+    bool construct,
+    bool *is_added)
+{
+    bool added;
+    void *result = ecs_sparse_storage_ensure(
+        world, storage, id, entity, construct, &added);
+
+    if (added) {
+        sparse_update_table(world, entity);
+    }
+
+    if (is_added) {
+        *is_added = added;
+    }
+
+    return result;
+}
+
+/* Add or remove ids that are not stored in tables. Returns the ids that still
+ * need to be added to/removed from the entity table. */
+static
+ecs_ids_t* add_remove_sparse(
+    ecs_world_t *world,
+    ecs_entity_t entity,
+    ecs_ids_t *components,
+    ecs_ids_t *table_ids,
+    bool remove)
+{
+    if (!world->store.sparse_ids) {
+        return components;
+    }
+
+    bool changed = false;
+    int32_t i, count = components->count;
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = components->array[i];
+        ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+        if (storage) {
+            bool is_added = false;
+            if (remove) {
+                changed |= ecs_sparse_storage_remove(
+                    world, storage, id, entity);
+            } else {
+                ecs_sparse_storage_ensure(
+                    world, storage, id, entity, true, &is_added);
+                changed |= is_added;
+            }
+        } else {
+            table_ids->array[table_ids->count ++] = id;
+        }
+    }
+
+    /* If ids are added to the table of the entity, it will end up in a table
+     * regardless, so only move it to the root table if there are none */
+    if (changed && (remove || !table_ids->count)) {
+        sparse_update_table(world, entity);
+    }
+
+    return table_ids;
+}
+
 static
 void add_ids(
     ecs_world_t *world,
@@ -1350,17 +1657,24 @@ void add_ids(
         return;
     }
 
-    ecs_entity_info_t info;
-    ecs_get_info(world, entity, &info);
+    ecs_entity_t table_buffer[ECS_MAX_ADD_REMOVE];
+    ecs_ids_t table_ids = { .array = table_buffer };
+    components = add_remove_sparse(
+        world, entity, components, &table_ids, false);
 
-    ecs_entity_t buffer[ECS_MAX_ADD_REMOVE];
-    ecs_ids_t added = { .array = buffer };
+    if (components->count) {
+        ecs_entity_info_t info;
+        ecs_get_info(world, entity, &info);
 
-    ecs_table_t *src_table = info.table;
-    ecs_table_t *dst_table = ecs_table_traverse_add(
-        world, src_table, components, &added);
+        ecs_entity_t buffer[ECS_MAX_ADD_REMOVE];
+        ecs_ids_t added = { .array = buffer };
 
-    commit(world, entity, &info, dst_table, &added, NULL, true);
+        ecs_table_t *src_table = info.table;
+        ecs_table_t *dst_table = ecs_table_traverse_add(
+            world, src_table, components, &added);
+
+        commit(world, entity, &info, dst_table, &added, NULL, true);
+    }
 
     ecs_defer_flush(world, stage);
 }
@@ -1379,17 +1693,24 @@ void remove_ids(
         return;
     }
 
-    ecs_entity_info_t info;
-    ecs_get_info(world, entity, &info);
+    ecs_entity_t table_buffer[ECS_MAX_ADD_REMOVE];
+    ecs_ids_t table_ids = { .array = table_buffer };
+    components = add_remove_sparse(
+        world, entity, components, &table_ids, true);
 
-    ecs_entity_t buffer[ECS_MAX_ADD_REMOVE];
-    ecs_ids_t removed = { .array = buffer };
+    if (components->count) {
+        ecs_entity_info_t info;
+        ecs_get_info(world, entity, &info);
 
-    ecs_table_t *src_table = info.table;
-    ecs_table_t *dst_table = ecs_table_traverse_remove(
-        world, src_table, components, &removed);
+        ecs_entity_t buffer[ECS_MAX_ADD_REMOVE];
+        ecs_ids_t removed = { .array = buffer };
 
-    commit(world, entity, &info, dst_table, NULL, &removed, true);
+        ecs_table_t *src_table = info.table;
+        ecs_table_t *dst_table = ecs_table_traverse_remove(
+            world, src_table, components, &removed);
+
+        commit(world, entity, &info, dst_table, NULL, &removed, true);
+    }
 
     ecs_defer_flush(world, stage);
 }
@@ -1407,6 +1728,11 @@ void *get_mutable(
     ecs_assert((component & ECS_COMPONENT_MASK) == component || 
         ECS_HAS_ROLE(component, PAIR), ECS_INVALID_PARAMETER, NULL);
 
+    /* The returned pointer can be used to change the name or symbol */
+    if (component == ecs_id(EcsName)) {
+        ecs_name_index_touch(world, entity);
+    }
+
     void *dst = NULL;
     if (ecs_get_info(world, entity, info) && info->table) {
         dst = get_component(world, info->table, info->row, component);
@@ -1538,12 +1864,26 @@ ecs_entity_t ecs_new_id(
 
     int32_t stage_count = ecs_get_stage_count(unsafe_world);
     if (stage->asynchronous || (ecs_os_has_threading() && stage_count > 1)) {
-        /* Can't atomically increase number above max int */
-        ecs_assert(
-            unsafe_world->stats.last_id < UINT_MAX, ECS_INTERNAL_ERROR, NULL);
+        /* A stage is only accessed by a single thread, so taking an id from
+         * its reserved block doesn't require synchronization. */
+        ecs_stage_t *unsafe_stage = (ecs_stage_t*)stage;
+        if (unsafe_stage->ids_created < ECS_MAX_STAGE_IDS) {
+            unsafe_stage->ids_created ++;
+        }
 
-        entity = (ecs_entity_t)ecs_os_ainc(
-            (int32_t*)&unsafe_world->stats.last_id);
+        if (!ecs_vector_pop(unsafe_stage->id_block, ecs_entity_t, &entity)) {
+            /* Can't atomically increase number above max int */
+            ecs_assert(unsafe_world->stats.last_id < UINT_MAX, 
+                ECS_INTERNAL_ERROR, NULL);
+
+            /* Asynchronous stages may be used without threading support */
+            if (ecs_os_has_threading()) {
+                entity = (ecs_entity_t)ecs_os_ainc(
+                    (int32_t*)&unsafe_world->stats.last_id);
+            } else {
+                entity = ++ unsafe_world->stats.last_id;
+            }
+        }
     } else {
         entity = ecs_eis_recycle(unsafe_world);
     }
@@ -1615,7 +1955,7 @@ ecs_entity_t ecs_new_w_type(
     }
 
     ecs_stage_t *stage = ecs_stage_from_world(&world);    
-    ecs_entity_t entity = ecs_new_id(world);
+    ecs_entity_t entity = ecs_new_id((ecs_world_t*)stage);
     ecs_id_t with = stage->with;
     ecs_entity_t scope = stage->scope;
 
@@ -1630,7 +1970,17 @@ ecs_entity_t ecs_new_w_type(
         return entity;
     }
 
-    new(world, entity, &to_add);
+    ecs_ids_t table_ids = { 
+        .array = ecs_os_alloca(ECS_SIZEOF(ecs_id_t) * to_add.count)
+    };
+    ecs_ids_t *table_add = add_remove_sparse(
+        world, entity, &to_add, &table_ids, false);
+
+    if (table_add->count) {
+        new(world, entity, table_add);
+    } else if (!to_add.count) {
+        ecs_eis_set(world, entity, &(ecs_record_t){ 0 });
+    }
 
     ecs_id_t ids[2];
     to_add = (ecs_entities_t){ .array = ids, .count = 0 };
@@ -1659,7 +2009,7 @@ ecs_entity_t ecs_new_w_id(
     ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
 
     ecs_stage_t *stage = ecs_stage_from_world(&world);    
-    ecs_entity_t entity = ecs_new_id(world);
+    ecs_entity_t entity = ecs_new_id((ecs_world_t*)stage);
 
     ecs_id_t ids[3];
     ecs_entities_t to_add = { .array = ids, .count = 0 };
@@ -1684,9 +2034,14 @@ ecs_entity_t ecs_new_w_id(
         return entity;
     } 
 
-    if (to_add.count) {
-        new(world, entity, &to_add);
-    } else {
+    ecs_id_t table_buffer[3];
+    ecs_entities_t table_ids = { .array = table_buffer };
+    ecs_entities_t *table_add = add_remove_sparse(
+        world, entity, &to_add, &table_ids, false);
+
+    if (table_add->count) {
+        new(world, entity, table_add);
+    } else if (!to_add.count) {
         ecs_eis_set(world, entity, &(ecs_record_t){ 0 });
     }
 
@@ -2388,7 +2743,12 @@ void ecs_clear(
         /* Remove all components */
         ecs_entities_t to_remove = ecs_type_to_entities(type);
         remove_ids_w_info(world, entity, &info, &to_remove);
-    }    
+    }
+
+    ecs_sparse_storage_clear(world, entity);
+
+    /* Entity could have been stored in the root table for its sparse ids */
+    sparse_update_table(world, entity);
 
     ecs_defer_flush(world, stage);
 }
@@ -2503,8 +2863,7 @@ void delete_objects(
 static
 void delete_tables_for_id_record(
     ecs_world_t *world,
-    ecs_id_t id,
-    ecs_id_record_t *idr)
+    ecs_id_t id)
 {
     /* Delete tables in id record. Because deleting the table updates the
      * map, remove the map pointer from the id record. This will prevent the
@@ -2512,6 +2871,13 @@ void delete_tables_for_id_record(
      * allows for iterating the map without changing it. */
     
     if (!world->is_fini) {
+        /* Get record again, as delete actions can remove other records from
+         * the id index, which can move this record to another address */
+        ecs_id_record_t *idr = ecs_get_id_record(world, id);
+        if (!idr) {
+            return;
+        }
+
         ecs_map_t *table_index = idr->table_index;
         idr->table_index = NULL;
         ecs_map_iter_t it = ecs_map_iter(table_index);
@@ -2568,7 +2934,7 @@ void on_delete_object_action(
             }
         }
 
-        delete_tables_for_id_record(world, id, idr);
+        delete_tables_for_id_record(world, id);
     }
 }
 
@@ -2599,7 +2965,7 @@ void on_delete_relation_action(
             }
         }
 
-        delete_tables_for_id_record(world, id, idr);
+        delete_tables_for_id_record(world, id);
     }
 }
 
@@ -2620,6 +2986,35 @@ void ecs_delete_children(
     on_delete_action(world, parent);
 }
 
+typedef struct table_row_t {
+    ecs_table_t *table;
+    int32_t row;
+    int32_t index;
+} table_row_t;
+
+static
+int table_row_compare(
+    const void *ptr1,
+    const void *ptr2)
+{
+    const table_row_t *e1 = ptr1;
+    const table_row_t *e2 = ptr2;
+
+    uint64_t t1 = e1->table->id, t2 = e2->table->id;
+    if (t1 != t2) {
+        return (t1 > t2) - (t1 < t2);
+    }
+
+    if (e1->row != e2->row) {
+        return (e1->row > e2->row) - (e1->row < e2->row);
+    }
+
+    /* An entity that is passed more than once keeps the order in which it was
+     * passed, so that ecs_set_many_id applies its last value last. Duplicates
+     * in ecs_delete_n end up next to each other and are deleted once. */
+    return (e1->index > e2->index) - (e1->index < e2->index);
+}
+
 void ecs_delete(
     ecs_world_t *world,
     ecs_entity_t entity)
@@ -2673,8 +3068,12 @@ void ecs_delete(
         ecs_assert(!table_id || table, ECS_INTERNAL_ERROR, NULL);
 
         /* If entity has components, remove them. Check if table is still alive,
-         * as delete actions could have deleted the table already. */
-        if (table_id && ecs_sparse_is_alive(world->store.tables, table_id)) {
+         * as delete actions could have deleted the table already. The root
+         * table, which stores entities with only sparse ids, is never deleted
+         * and is not in the table storage. */
+        if ((table && table == &world->store.root) ||
+            (table_id && ecs_sparse_is_alive(world->store.tables, table_id)))
+        {
             ecs_type_t type = table->type;
             ecs_ids_t to_remove = ecs_type_to_entities(type);
             delete_entity(world, table, info.data, info.row, &to_remove);
@@ -2683,6 +3082,9 @@ void ecs_delete(
 
         r->row = 0;
 
+        /* Remove components that are not stored in tables */
+        ecs_sparse_storage_clear(world, entity);
+
         /* Remove (and invalidate) entity after executing handlers */
         ecs_sparse_remove(world->store.entity_index, entity);
     }
@@ -2690,6 +3092,137 @@ void ecs_delete(
     ecs_defer_flush(world, stage);
 }
 
+void ecs_delete_n(
+    ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || entities != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (!count) {
+        return;
+    }
+
+    ecs_stage_t *stage = ecs_stage_from_world(&world);
+    ecs_sparse_t *entity_index = world->store.entity_index;
+    int32_t i;
+
+    if (stage->defer) {
+        for (i = 0; i < count; i ++) {
+            ecs_delete(world, entities[i]);
+        }
+        return;
+    }
+
+    /* Entities that are watched can have delete actions, and tables with 
+     * switch or bitset columns can't delete multiple rows at once. Delete these
+     * one by one before collecting rows, as this can move other entities. */
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i];
+        ecs_assert(e != 0, ECS_INVALID_PARAMETER, NULL);
+
+        ecs_record_t *r = ecs_sparse_get_sparse(entity_index, ecs_record_t, e);
+        if (!r) {
+            continue;
+        }
+
+        ecs_table_t *table = r->table;
+        if (r->row < 0 || (table && 
+            (table->flags & (EcsTableHasSwitch | EcsTableHasDisabled)))) 
+        {
+            ecs_delete(world, e);
+        }
+    }
+
+    table_row_t *elems = ecs_os_malloc(ECS_SIZEOF(table_row_t) * count);
+    int32_t *rows = ecs_os_malloc(ECS_SIZEOF(int32_t) * count);
+    int32_t elem_count = 0;
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i];
+        ecs_record_t *r = ecs_sparse_get_sparse(entity_index, ecs_record_t, e);
+        if (!r) {
+            continue;
+        }
+
+        if (!r->table) {
+            ecs_sparse_storage_clear(world, e);
+            ecs_sparse_remove(entity_index, e);
+            continue;
+        }
+
+        bool is_watched;
+        elems[elem_count].table = r->table;
+        elems[elem_count].row = ecs_record_to_row(r->row, &is_watched);
+        elems[elem_count].index = i;
+        elem_count ++;
+    }
+
+    qsort(elems, ecs_to_size_t(elem_count), sizeof(table_row_t), 
+        table_row_compare);
+
+    /* Defer operations from remove actions until all entities are deleted */
+    ecs_defer_none(world, stage);
+
+    int32_t cur = 0;
+    while (cur < elem_count) {
+        ecs_table_t *table = elems[cur].table;
+        ecs_data_t *data = ecs_table_get_data(table);
+        ecs_ids_t to_remove = ecs_type_to_entities(table->type);
+        int32_t first_elem = cur, row_count = 0;
+
+        /* Collect unique rows for table */
+        for (; cur < elem_count && elems[cur].table == table; cur ++) {
+            int32_t row = elems[cur].row;
+            if (!row_count || rows[row_count - 1] != row) {
+                rows[row_count ++] = row;
+            }
+        }
+
+        /* Invoke remove actions once per range of consecutive rows */
+        for (i = 0; i < row_count; ) {
+            int32_t first = rows[i ++], last = first + 1;
+            while (i < row_count && rows[i] == last) {
+                last ++;
+                i ++;
+            }
+
+            ecs_run_monitors(world, table, &table->un_set_all, 
+                first, last - first, NULL);
+
+            if (table->flags & EcsTableHasRemoveActions) {
+                ecs_run_remove_actions(
+                    world, table, data, first, last - first, &to_remove);
+            }
+        }
+
+        ecs_table_delete_rows(world, table, data, rows, row_count, true);
+
+        /* Remove (and invalidate) entities after executing handlers */
+        for (i = first_elem; i < cur; i ++) {
+            ecs_entity_t e = entities[elems[i].index];
+            ecs_record_t *r = ecs_sparse_get_sparse(
+                entity_index, ecs_record_t, e);
+            if (!r) {
+                /* Entity was specified more than once */
+                continue;
+            }
+
+            r->table = NULL;
+            r->row = 0;
+
+            ecs_sparse_storage_clear(world, e);
+            ecs_sparse_remove(entity_index, e);
+        }
+    }
+
+    ecs_os_free(rows);
+    ecs_os_free(elems);
+
+    ecs_defer_flush(world, stage);
+}
+
 void ecs_add_type(
     ecs_world_t *world,
     ecs_entity_t entity,
@@ -2783,7 +3316,7 @@ ecs_entity_t ecs_clone(
     ecs_stage_t *stage = ecs_stage_from_world(&world);
     
     if (!dst) {
-        dst = ecs_new_id(world);
+        dst = ecs_new_id((ecs_world_t*)stage);
     }
 
     if (ecs_defer_clone(world, stage, dst, src, copy_value)) {
@@ -2837,20 +3370,24 @@ const void* ecs_get_id(
         return NULL;
     }
 
-    ecs_table_t *table = r->table;
-    if (!table) {
+    ecs_id_record_t *idr = ecs_get_id_record(world, id);
+    if (!idr) {
         return NULL;
     }
 
-    ecs_id_record_t *idr = ecs_get_id_record(world, id);
-    if (!idr) {
+    if (idr->sparse) {
+        return ecs_sparse_storage_get_ptr(idr->sparse, entity);
+    }
+
+    ecs_table_t *table = r->table;
+    if (!table) {
         return NULL;
     }
 
     ecs_table_record_t *tr = ecs_map_get(idr->table_index, 
         ecs_table_record_t, table->id);
     if (!tr) {
-       return get_base_component(world, table, id, idr->table_index, NULL, 0);
+       return get_cached_base_component(world, table, id, idr->table_index);
     }
 
     bool is_monitored;
@@ -2859,6 +3396,93 @@ const void* ecs_get_id(
     return get_component_w_index(table, tr->column, row);
 }
 
+void ecs_get_many_id(
+    const ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t id,
+    const void **ptrs)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || entities != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || ptrs != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(ecs_stage_from_readonly_world(world)->asynchronous == false, 
+        ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    /* The id record is the same for all entities, so only look it up once */
+    ecs_id_record_t *idr = ecs_get_id_record(world, id);
+    int32_t i;
+
+    if (!idr) {
+        ecs_os_memset(ptrs, 0, count * ECS_SIZEOF(void*));
+        return;
+    }
+
+    if (idr->sparse) {
+        for (i = 0; i < count; i ++) {
+            ptrs[i] = ecs_sparse_storage_get_ptr(idr->sparse, entities[i]);
+        }
+        return;
+    }
+
+    /* Lookup & prefetch all records before they are accessed, so that loads 
+     * for different entities overlap instead of stalling one after another. 
+     * The output array is used to temporarily store the record pointers. */
+    for (i = 0; i < count; i ++) {
+        ecs_assert(ecs_is_valid(world, entities[i]), 
+            ECS_INVALID_PARAMETER, NULL);
+        ecs_record_t *r = ecs_eis_get(world, entities[i]);
+        ECS_PREFETCH(r);
+        ptrs[i] = r;
+    }
+
+    ecs_table_t *cur_table = NULL;
+    ecs_table_record_t *tr = NULL;
+    void *column_data = NULL;
+    ecs_size_t size = 0;
+
+    for (i = 0; i < count; i ++) {
+        const ecs_record_t *r = ptrs[i];
+        ecs_table_t *table;
+
+        if (!r || !(table = r->table)) {
+            ptrs[i] = NULL;
+            continue;
+        }
+
+        /* Entities often are stored in the same table as the previous entity,
+         * in which case the column lookup can be reused. */
+        if (table != cur_table) {
+            cur_table = table;
+            tr = ecs_map_get(idr->table_index, ecs_table_record_t, table->id);
+            if (tr) {
+                ecs_assert(tr->column < table->column_count, 
+                    ECS_NOT_A_COMPONENT, NULL);
+                ecs_data_t *data = ecs_table_get_data(table);
+                ecs_column_t *column = &data->columns[tr->column];
+                size = column->size;
+                ecs_assert(size != 0, ECS_INVALID_PARAMETER, NULL);
+                column_data = ecs_vector_first_t(
+                    column->data, size, column->alignment);
+            }
+        }
+
+        if (!tr) {
+            ptrs[i] = get_cached_base_component(
+                world, table, id, idr->table_index);
+            continue;
+        }
+
+        bool is_monitored;
+        int32_t row = ecs_record_to_row(r->row, &is_monitored);
+        void *ptr = ECS_OFFSET(column_data, size * row);
+        ECS_PREFETCH(ptr);
+        ptrs[i] = ptr;
+    }
+}
+
 const void* ecs_get_ref_w_id(
     const ecs_world_t * world,
     ecs_ref_t * ref,
@@ -2876,6 +3500,11 @@ const void* ecs_get_ref_w_id(
 
     entity |= ref->entity;
 
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, id | ref->component);
+    if (storage) {
+        return ecs_sparse_storage_get_ptr(storage, entity);
+    }
+
     if (!record) {
         record = ecs_eis_get(world, entity);
     }
@@ -2934,6 +3563,14 @@ void* ecs_get_mut_id(
         return result;
     }
 
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+    if (storage) {
+        /* Values in sparse storage have stable pointers */
+        result = ensure_sparse(world, storage, id, entity, true, is_added);
+        ecs_defer_flush(world, stage);
+        return result;
+    }
+
     ecs_entity_info_t info;
     result = get_mutable(world, entity, id, &info, is_added);
     
@@ -2988,6 +3625,13 @@ void* ecs_emplace_id(
         return result;
     }
 
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+    if (storage) {
+        result = ensure_sparse(world, storage, id, entity, false, NULL);
+        ecs_defer_flush(world, stage);
+        return result;
+    }
+
     ecs_entity_info_t info;
     ecs_get_info(world, entity, &info);
 
@@ -2999,6 +3643,11 @@ void* ecs_emplace_id(
     add_ids_w_info(world, entity, &info, &to_add, 
         false /* Add component without constructing it */ );
 
+    /* The returned pointer can be used to set the name or symbol */
+    if (id == ecs_id(EcsName)) {
+        ecs_name_index_touch(world, entity);
+    }
+
     void *ptr = get_component(world, info.table, info.row, id);
 
     ecs_defer_flush(world, stage);
@@ -3028,6 +3677,16 @@ void ecs_modified_id(
     ecs_assert(ecs_has_id(world, entity, id), 
         ECS_INVALID_PARAMETER, NULL);
 
+    if (id == ecs_id(EcsName)) {
+        ecs_name_index_touch(world, entity);
+    }
+
+    /* Ids with sparse storage don't emit OnSet events */
+    if (ecs_sparse_storage_get(world, id)) {
+        ecs_defer_flush(world, stage);
+        return;
+    }
+
     ecs_entity_info_t info = {0};
     if (ecs_get_info(world, entity, &info)) {
         ecs_ids_t added = {
@@ -3061,7 +3720,7 @@ ecs_entity_t assign_ptr_w_id(
     };
 
     if (!entity) {
-        entity = ecs_new_id(world);
+        entity = ecs_new_id((ecs_world_t*)stage);
         ecs_entity_t scope = stage->scope;
         if (scope) {
             ecs_add_pair(world, entity, EcsChildOf, scope);
@@ -3075,8 +3734,14 @@ ecs_entity_t assign_ptr_w_id(
     }
 
     ecs_entity_info_t info;
+    void *dst;
 
-    void *dst = get_mutable(world, entity, id, &info, NULL);
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+    if (storage) {
+        dst = ensure_sparse(world, storage, id, entity, true, NULL);
+    } else {
+        dst = get_mutable(world, entity, id, &info, NULL);
+    }
 
     /* This can no longer happen since we defer operations */
     ecs_assert(dst != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -3109,11 +3774,13 @@ ecs_entity_t assign_ptr_w_id(
         memset(dst, 0, size);
     }
 
-    ecs_table_mark_dirty(info.table, id);
+    if (!storage) {
+        ecs_table_mark_dirty(info.table, id);
 
-    if (notify) {
-        ecs_run_set_systems(world, &added, 
-            info.table, info.data, info.row, 1, false);
+        if (notify) {
+            ecs_run_set_systems(world, &added, 
+                info.table, info.data, info.row, 1, false);
+        }
     }
 
     ecs_defer_flush(world, stage);
@@ -3137,6 +3804,143 @@ ecs_entity_t ecs_set_id(
         world, entity, id, size, (void*)ptr, false, true);
 }
 
+void ecs_set_many_id(
+    ecs_world_t *world,
+    const ecs_entity_t *entities,
+    int32_t count,
+    ecs_id_t id,
+    size_t size,
+    const void *values)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || entities != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || values != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(ecs_is_valid(world, id), ECS_INVALID_PARAMETER, NULL);
+
+    if (!count) {
+        return;
+    }
+
+    ecs_stage_t *stage = ecs_stage_from_world(&world);
+    ecs_size_t elem_size = ecs_from_size_t(size);
+    int32_t i;
+
+    /* If operations are deferred or the component is not stored in tables 
+     * there is nothing to group, so set the values one by one. */
+    if (stage->defer || ecs_sparse_storage_get(world, id)) {
+        for (i = 0; i < count; i ++) {
+            ecs_set_id(world, entities[i], id, size, 
+                ECS_OFFSET(values, elem_size * i));
+        }
+        return;
+    }
+
+    /* Make sure all entities have the component before collecting rows, as
+     * moving an entity to another table can change the row of other entities */
+    ecs_table_t *table = NULL;
+    ecs_table_t *has_table = NULL;
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i];
+        ecs_assert(ecs_is_valid(world, e), ECS_INVALID_PARAMETER, NULL);
+        ecs_record_t *r = ecs_eis_get(world, e);
+        table = r ? r->table : NULL;
+        if (table && table == has_table) {
+            continue;
+        }
+
+        if (table && ecs_type_index_of(table->type, id) != -1) {
+            has_table = table;
+            continue;
+        }
+
+        ecs_add_id(world, e, id);
+    }
+
+    if (id == ecs_id(EcsName)) {
+        for (i = 0; i < count; i ++) {
+            ecs_name_index_touch(world, entities[i]);
+        }
+    }
+
+    ecs_id_record_t *idr = ecs_get_id_record(world, id);
+    ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    table_row_t *elems = ecs_os_malloc(ECS_SIZEOF(table_row_t) * count);
+    for (i = 0; i < count; i ++) {
+        ecs_record_t *r = ecs_eis_get(world, entities[i]);
+        ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(r->table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        bool is_monitored;
+        elems[i].table = r->table;
+        elems[i].row = ecs_record_to_row(r->row, &is_monitored);
+        elems[i].index = i;
+    }
+
+    qsort(elems, ecs_to_size_t(count), sizeof(table_row_t), 
+        table_row_compare);
+
+    /* Defer operations from OnSet triggers & systems until all values are set */
+    ecs_defer_none(world, stage);
+
+    ecs_entity_t real_id = ecs_get_typeid(world, id);
+    const ecs_type_info_t *c_info = get_c_info(world, real_id);
+    ecs_copy_t copy = c_info ? c_info->lifecycle.copy : NULL;
+    ecs_ids_t set_ids = { .array = &id, .count = 1 };
+
+    int32_t cur = 0;
+    while (cur < count) {
+        table = elems[cur].table;
+
+        ecs_table_record_t *tr = ecs_map_get(
+            idr->table_index, ecs_table_record_t, table->id);
+        ecs_assert(tr != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(tr->column < table->column_count, ECS_NOT_A_COMPONENT, NULL);
+
+        ecs_data_t *data = ecs_table_get_data(table);
+        ecs_column_t *column = &data->columns[tr->column];
+        ecs_assert(column->size == elem_size, ECS_INVALID_PARAMETER, NULL);
+        void *column_data = ecs_vector_first_t(
+            column->data, elem_size, column->alignment);
+        ecs_entity_t *table_entities = ecs_vector_first(
+            data->entities, ecs_entity_t);
+
+        /* Copy values for all entities in the table, and invoke OnSet for 
+         * each range of consecutive rows */
+        int32_t first = elems[cur].row, last = first - 1;
+        for (; cur < count && elems[cur].table == table; cur ++) {
+            /* If the row is not adjacent to the previous row (or is the same
+             * row when an entity is set twice), the range ends */
+            int32_t row = elems[cur].row;
+            if (row != last + 1) {
+                ecs_run_set_systems(world, &set_ids, table, data, first, 
+                    last - first + 1, false);
+                first = row;
+            }
+            last = row;
+
+            void *dst = ECS_OFFSET(column_data, elem_size * row);
+            const void *src = ECS_OFFSET(values, elem_size * elems[cur].index);
+            if (copy) {
+                ecs_entity_t *e = &table_entities[row];
+                copy(world, real_id, e, e, dst, src, size, 1, 
+                    c_info->lifecycle.ctx);
+            } else {
+                ecs_os_memcpy(dst, src, elem_size);
+            }
+        }
+
+        ecs_run_set_systems(world, &set_ids, table, data, first, 
+            last - first + 1, false);
+
+        ecs_table_mark_dirty(table, id);
+    }
+
+    ecs_os_free(elems);
+
+    ecs_defer_flush(world, stage);
+}
+
 ecs_entity_t ecs_get_case(
     const ecs_world_t *world,
     ecs_entity_t entity,
@@ -3267,6 +4071,11 @@ bool ecs_has_id(
     /* Make sure we're not working with a stage */
     world = ecs_get_world(world);
 
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+    if (storage) {
+        return ecs_sparse_storage_get_ptr(storage, entity) != NULL;
+    }
+
     if (ECS_HAS_ROLE(id, CASE)) {
         ecs_entity_info_t info;
         ecs_table_t *table;
@@ -3312,6 +4121,42 @@ ecs_entity_t ecs_get_object_w_id(
         return 0;
     }
 
+    world = ecs_get_world(world);
+
+    /* If no id is provided, return the first valid object of the relation. The
+     * id index stores where the pairs for the relation start in the table, and
+     * pairs for the same relation are stored next to each other. */
+    if (!id) {
+        ecs_record_t *r = ecs_eis_get(world, entity);
+        ecs_table_t *table;
+        if (!r || !(table = r->table)) {
+            return 0;
+        }
+
+        ecs_id_record_t *idr = ecs_get_id_record(
+            world, ecs_pair(rel, EcsWildcard));
+        if (!idr) {
+            return 0;
+        }
+
+        ecs_table_record_t *tr = ecs_map_get(
+            idr->table_index, ecs_table_record_t, table->id);
+        if (!tr) {
+            return 0;
+        }
+
+        ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
+        int32_t i, end = tr->column + tr->count;
+        for (i = tr->column; i < end; i ++) {
+            ecs_entity_t object = ecs_pair_object(world, ids[i]);
+            if (ecs_is_valid(world, object)) {
+                return ecs_get_alive(world, object);
+            }
+        }
+
+        return 0;
+    }
+
     ecs_type_t type = ecs_get_type(world, entity);    
     ecs_entity_t object;
 
@@ -3624,6 +4469,17 @@ bool ecs_defer_end(
     return ecs_defer_flush(world, stage);
 }
 
+bool ecs_enable_on_set_coalescing(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_OPERATION, NULL);
+    bool old_value = world->coalesce_on_set;
+    world->coalesce_on_set = enable;
+    return old_value;
+}
+
 static
 size_t append_to_str(
     char **buffer,
@@ -3870,6 +4726,120 @@ bool valid_components(
     return true;
 }
 
+typedef struct on_set_event_t {
+    ecs_entity_t entity;
+    ecs_id_t id;
+    ecs_table_t *table;
+    int32_t row;
+} on_set_event_t;
+
+static
+void coalesce_on_set(
+    ecs_world_t *world,
+    ecs_vector_t **events,
+    ecs_entity_t entity,
+    ecs_id_t id)
+{
+    /* Ids with sparse storage don't emit OnSet events */
+    if (ecs_sparse_storage_get(world, id)) {
+        return;
+    }
+
+    on_set_event_t *ev = ecs_vector_add(events, on_set_event_t);
+    ev->entity = entity;
+    ev->id = id;
+}
+
+static
+int on_set_event_compare(
+    const void *ptr1,
+    const void *ptr2)
+{
+    const on_set_event_t *e1 = ptr1;
+    const on_set_event_t *e2 = ptr2;
+
+    if (e1->id != e2->id) {
+        return (e1->id > e2->id) - (e1->id < e2->id);
+    }
+
+    uint64_t t1 = e1->table->id, t2 = e2->table->id;
+    if (t1 != t2) {
+        return (t1 > t2) - (t1 < t2);
+    }
+
+    return (e1->row > e2->row) - (e1->row < e2->row);
+}
+
+/* Deliver OnSet events that were coalesced while flushing. Events are sorted by
+ * id and table, so that events for the same entity are adjacent and events for
+ * consecutive rows are delivered as a single range. */
+static
+void flush_on_set_events(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_vector_t *events)
+{
+    on_set_event_t *arr = ecs_vector_first(events, on_set_event_t);
+    int32_t i, count = ecs_vector_count(events), valid_count = 0;
+
+    /* Get the current table and row of the entities. Drop events for entities
+     * that were deleted or components that were removed by a later operation */
+    for (i = 0; i < count; i ++) {
+        on_set_event_t *ev = &arr[i];
+        if (!ecs_is_alive(world, ev->entity)) {
+            continue;
+        }
+
+        ecs_record_t *r = ecs_eis_get(world, ev->entity);
+        ecs_table_t *table = r ? r->table : NULL;
+        if (!table || ecs_type_index_of(table->type, ev->id) == -1) {
+            continue;
+        }
+
+        bool is_watched;
+        ev->table = table;
+        ev->row = ecs_record_to_row(r->row, &is_watched);
+        arr[valid_count ++] = *ev;
+    }
+
+    qsort(arr, ecs_to_size_t(valid_count), sizeof(on_set_event_t), 
+        on_set_event_compare);
+
+    /* Defer operations of reactive systems, so that entities don't move while
+     * events are delivered */
+    ecs_defer_none(world, stage);
+
+    for (i = 0; i < valid_count; ) {
+        on_set_event_t *first = &arr[i];
+        int32_t row = first->row, end = row + 1;
+
+        for (i ++; i < valid_count; i ++) {
+            on_set_event_t *ev = &arr[i];
+            if (ev->id != first->id || ev->table != first->table) {
+                break;
+            }
+
+            /* Skip duplicate events for the same entity */
+            if (ev->row == end) {
+                end ++;
+            } else if (ev->row != (end - 1)) {
+                break;
+            }
+        }
+
+        ecs_ids_t ids = {
+            .array = &first->id,
+            .count = 1
+        };
+
+        ecs_table_mark_dirty(first->table, first->id);
+        ecs_run_set_systems(world, &ids, first->table, 
+            ecs_table_get_data(first->table), row, end - row, false);
+    }
+
+    ecs_defer_flush(world, stage);
+}
+
 /* Leave safe section. Run all deferred commands. */
 bool ecs_defer_flush(
     ecs_world_t *world,
@@ -3889,6 +4859,8 @@ bool ecs_defer_flush(
         if (defer_queue) {
             ecs_op_t *ops = ecs_vector_first(defer_queue, ecs_op_t);
             int32_t i, count = ecs_vector_count(defer_queue);
+            bool coalesce = world->coalesce_on_set;
+            ecs_vector_t *on_set_events = NULL;
             
             for (i = 0; i < count; i ++) {
                 ecs_op_t *op = &ops[i];
@@ -3931,7 +4903,11 @@ bool ecs_defer_flush(
                 case EcsOpSet:
                     assign_ptr_w_id(world, e, 
                         op->component, ecs_to_size_t(op->is._1.size), 
-                        op->is._1.value, true, true);
+                        op->is._1.value, true, !coalesce);
+                    if (coalesce) {
+                        coalesce_on_set(
+                            world, &on_set_events, e, op->component);
+                    }
                     break;
                 case EcsOpMut:
                     assign_ptr_w_id(world, e, 
@@ -3939,7 +4915,12 @@ bool ecs_defer_flush(
                         op->is._1.value, true, false);
                     break;
                 case EcsOpModified:
-                    ecs_modified_id(world, e, op->component);
+                    if (coalesce) {
+                        coalesce_on_set(
+                            world, &on_set_events, e, op->component);
+                    } else {
+                        ecs_modified_id(world, e, op->component);
+                    }
                     break;
                 case EcsOpDelete: {
                     ecs_delete(world, e);
@@ -3980,6 +4961,11 @@ bool ecs_defer_flush(
             /* Restore defer queue */
             ecs_vector_clear(defer_queue);
             stage->defer_queue = defer_queue;
+
+            if (on_set_events) {
+                flush_on_set_events(world, stage, on_set_events);
+                ecs_vector_free(on_set_events);
+            }
         }
 
         return true;
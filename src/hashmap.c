@@ -1,54 +1,170 @@
 #include "private_api.h"
 
-typedef struct ecs_hm_bucket_t {
-    ecs_vector_t *keys;
-    ecs_vector_t *values;
-} ecs_hm_bucket_t;
+/* Hash values that indicate a slot is not occupied. Hashes of elements that
+ * collide with these values are offset so they are never stored. */
+#define HASH_EMPTY (0)
+#define HASH_TOMBSTONE (1)
+
+/* Minimum number of slots in a map that is not empty */
+#define MIN_SLOT_COUNT (8)
+
+/* Slots are stored as: [hash][key][value], with key & value aligned to 8 */
+typedef struct ecs_hm_slots_t {
+    void *slots;            /* Slot array */
+    ecs_size_t key_size;
+    ecs_size_t value_size;
+    ecs_size_t value_offset;/* Offset of value in slot */
+    ecs_size_t slot_size;   /* Size of slot, including hash */
+    int32_t slot_count;     /* Number of slots, always a power of 2 */
+    int32_t count;          /* Number of elements */
+    int32_t tombstones;     /* Number of slots with a removed element */
+} ecs_hm_slots_t;
+
+#define SLOT(impl, index)\
+    ECS_OFFSET((impl)->slots, (impl)->slot_size * (index))
+#define SLOT_HASH(slot) (*(uint64_t*)(slot))
+#define SLOT_KEY(slot) ECS_OFFSET(slot, ECS_SIZEOF(uint64_t))
+#define SLOT_VALUE(impl, slot) ECS_OFFSET(slot, (impl)->value_offset)
 
 static
-int32_t find_key(
-    ecs_hashmap_t map,
-    ecs_vector_t *keys,
-    ecs_size_t key_size, 
-    const void *key)
+uint64_t slot_hash(
+    uint64_t hash)
 {
-    int32_t i, count = ecs_vector_count(keys);
-    void *key_array = ecs_vector_first_t(keys, key_size, 8);
-    for (i = 0; i < count; i ++) {
-        void *key_ptr = ECS_OFFSET(key_array, key_size * i);
-        if (map.compare(key_ptr, key) == 0) {
-            return i;
+    if (hash <= HASH_TOMBSTONE) {
+        hash += HASH_TOMBSTONE + 1;
+    }
+    return hash;
+}
+
+/* Find slot for key. Returns the index of the slot, or -1 if not found. */
+static
+int32_t find_slot(
+    const ecs_hashmap_t map,
+    const void *key,
+    uint64_t hash)
+{
+    ecs_hm_slots_t *impl = map.impl;
+    int32_t slot_count = impl->slot_count;
+    if (!slot_count) {
+        return -1;
+    }
+
+    int32_t mask = slot_count - 1;
+    int32_t i, index = (int32_t)(hash & (uint64_t)mask);
+
+    for (i = 0; i < slot_count; i ++) {
+        void *slot = SLOT(impl, index);
+        uint64_t slot_h = SLOT_HASH(slot);
+        if (slot_h == HASH_EMPTY) {
+            return -1;
+        }
+
+        if (slot_h == hash && !map.compare(SLOT_KEY(slot), key)) {
+            return index;
         }
+
+        index = (index + 1) & mask;
     }
+
     return -1;
 }
 
+/* Find slot in which a new element with the specified hash can be stored */
+static
+int32_t find_free_slot(
+    const ecs_hm_slots_t *impl,
+    uint64_t hash)
+{
+    int32_t mask = impl->slot_count - 1;
+    int32_t index = (int32_t)(hash & (uint64_t)mask);
+
+    while (SLOT_HASH(SLOT(impl, index)) > HASH_TOMBSTONE) {
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+/* Reinsert elements into new slot array. This does not need to compare keys,
+ * as keys in the map are unique. */
+static
+void rehash(
+    ecs_hm_slots_t *impl,
+    int32_t slot_count)
+{
+    void *old_slots = impl->slots;
+    int32_t i, old_count = impl->slot_count;
+
+    impl->slots = ecs_os_calloc(impl->slot_size * slot_count);
+    ecs_assert(impl->slots != NULL, ECS_OUT_OF_MEMORY, NULL);
+    impl->slot_count = slot_count;
+    impl->tombstones = 0;
+
+    for (i = 0; i < old_count; i ++) {
+        void *slot = ECS_OFFSET(old_slots, impl->slot_size * i);
+        uint64_t hash = SLOT_HASH(slot);
+        if (hash > HASH_TOMBSTONE) {
+            int32_t index = find_free_slot(impl, hash);
+            ecs_os_memcpy(SLOT(impl, index), slot, impl->slot_size);
+        }
+    }
+
+    ecs_os_free(old_slots);
+}
+
+/* Make sure there is room for one more element. Tombstones are counted as
+ * occupied slots, as they don't end a probe. When most occupied slots are
+ * tombstones, the map is rehashed without growing. */
+static
+void ensure_free_slot(
+    ecs_hm_slots_t *impl)
+{
+    int32_t slot_count = impl->slot_count;
+    int32_t occupied = impl->count + impl->tombstones + 1;
+    if ((occupied * 4) <= (slot_count * 3)) {
+        return;
+    }
+
+    int32_t new_count = ecs_next_pow_of_2((impl->count + 1) * 2);
+    if (new_count < MIN_SLOT_COUNT) {
+        new_count = MIN_SLOT_COUNT;
+    }
+
+    rehash(impl, new_count);
+}
+
 ecs_hashmap_t _ecs_hashmap_new(
     ecs_size_t key_size,
     ecs_size_t value_size,
     ecs_hash_value_action_t hash,
     ecs_compare_action_t compare)
 {
+    ecs_hm_slots_t *impl = ecs_os_calloc(ECS_SIZEOF(ecs_hm_slots_t));
+    ecs_assert(impl != NULL, ECS_OUT_OF_MEMORY, NULL);
+
+    ecs_size_t value_offset = ECS_SIZEOF(uint64_t) + ECS_ALIGN(key_size, 8);
+    impl->key_size = key_size;
+    impl->value_size = value_size;
+    impl->value_offset = value_offset;
+    impl->slot_size = value_offset + ECS_ALIGN(value_size, 8);
+
     return (ecs_hashmap_t){
         .key_size = key_size,
         .value_size = value_size,
         .compare = compare,
         .hash = hash,
-        .impl = ecs_map_new(ecs_hm_bucket_t, 0)
+        .impl = impl
     };
 }
 
 void ecs_hashmap_free(
     ecs_hashmap_t map)
 {
-    ecs_map_iter_t it = ecs_map_iter(map.impl);
-    ecs_hm_bucket_t *bucket;
-    while ((bucket = ecs_map_next(&it, ecs_hm_bucket_t, NULL))) {
-        ecs_vector_free(bucket->keys);
-        ecs_vector_free(bucket->values);
+    ecs_hm_slots_t *impl = map.impl;
+    if (impl) {
+        ecs_os_free(impl->slots);
+        ecs_os_free(impl);
     }
-
-    ecs_map_free(map.impl);
 }
 
 void* _ecs_hashmap_get(
@@ -60,18 +176,13 @@ void* _ecs_hashmap_get(
     ecs_assert(map.key_size == key_size, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(map.value_size == value_size, ECS_INVALID_PARAMETER, NULL);
 
-    uint64_t hash = map.hash(key);
-    ecs_hm_bucket_t *bucket = ecs_map_get(map.impl, ecs_hm_bucket_t, hash);
-    if (!bucket) {
-        return NULL;
-    }
-
-    int32_t index = find_key(map, bucket->keys, key_size, key);
+    uint64_t hash = slot_hash(map.hash(key));
+    int32_t index = find_slot(map, key, hash);
     if (index == -1) {
         return NULL;
     }
 
-    return ecs_vector_get_t(bucket->values, value_size, 8, index);
+    return SLOT_VALUE(map.impl, SLOT(map.impl, index));
 }
 
 ecs_hashmap_result_t _ecs_hashmap_ensure(
@@ -83,37 +194,32 @@ ecs_hashmap_result_t _ecs_hashmap_ensure(
     ecs_assert(map.key_size == key_size, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(map.value_size == value_size, ECS_INVALID_PARAMETER, NULL);
 
+    ecs_hm_slots_t *impl = map.impl;
     uint64_t hash = map.hash(key);
-    ecs_hm_bucket_t *bucket = ecs_map_ensure(map.impl, ecs_hm_bucket_t, hash);
-    ecs_assert(bucket != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    void *value_ptr, *key_ptr;
-
-    ecs_vector_t *keys = bucket->keys;
-    if (!keys) {
-        bucket->keys = ecs_vector_new_t(key_size, 8, 1);
-        bucket->values = ecs_vector_new_t(value_size, 8, 1);
-        key_ptr = ecs_vector_add_t(&bucket->keys, key_size, 8);
-        ecs_os_memcpy(key_ptr, key, key_size);
-        value_ptr = ecs_vector_add_t(&bucket->values, value_size, 8);
-        ecs_os_memset(value_ptr, 0, value_size);
-    } else {
-        int32_t index = find_key(map, keys, key_size, key);
-        if (index == -1) {
-            key_ptr = ecs_vector_add_t(&bucket->keys, key_size, 8);
-            ecs_os_memcpy(key_ptr, key, key_size);
-            value_ptr = ecs_vector_add_t(&bucket->values, value_size, 8);
-            ecs_assert(value_ptr != NULL, ECS_INTERNAL_ERROR, NULL);
-            ecs_os_memset(value_ptr, 0, value_size);
-        } else {
-            key_ptr = ecs_vector_get_t(bucket->keys, key_size, 8, index);
-            value_ptr = ecs_vector_get_t(bucket->values, value_size, 8, index);
+    uint64_t h = slot_hash(hash);
+    void *slot;
+
+    int32_t index = find_slot(map, key, h);
+    if (index == -1) {
+        ensure_free_slot(impl);
+        index = find_free_slot(impl, h);
+        slot = SLOT(impl, index);
+
+        if (SLOT_HASH(slot) == HASH_TOMBSTONE) {
+            impl->tombstones --;
         }
+
+        SLOT_HASH(slot) = h;
+        ecs_os_memcpy(SLOT_KEY(slot), key, key_size);
+        ecs_os_memset(SLOT_VALUE(impl, slot), 0, value_size);
+        impl->count ++;
+    } else {
+        slot = SLOT(impl, index);
     }
 
     return (ecs_hashmap_result_t){
-        .key = key_ptr,
-        .value = value_ptr,
+        .key = SLOT_KEY(slot),
+        .value = SLOT_VALUE(impl, slot),
         .hash = hash
     };
 }
@@ -137,24 +243,26 @@ void _ecs_hashmap_remove_w_hash(
     ecs_size_t value_size,
     uint64_t hash)
 {
-    ecs_hm_bucket_t *bucket = ecs_map_get(map.impl, ecs_hm_bucket_t, hash);
-    if (!bucket) {
-        return;
-    }
+    (void)key_size;
+    (void)value_size;
 
-    int32_t index = find_key(map, bucket->keys, key_size, key);
+    ecs_hm_slots_t *impl = map.impl;
+    int32_t index = find_slot(map, key, slot_hash(hash));
     if (index == -1) {
         return;
     }
 
-    ecs_vector_remove_t(bucket->keys, key_size, 8, index);
-    ecs_vector_remove_t(bucket->values, value_size, 8, index);
-
-    if (!ecs_vector_count(bucket->keys)) {
-        ecs_vector_free(bucket->keys);
-        ecs_vector_free(bucket->values);
-        ecs_map_remove(map.impl, hash);
+    /* If the next slot is empty, no probe continues past this slot, and it can
+     * be marked as empty instead of leaving a tombstone. */
+    int32_t next = (index + 1) & (impl->slot_count - 1);
+    if (SLOT_HASH(SLOT(impl, next)) == HASH_EMPTY) {
+        SLOT_HASH(SLOT(impl, index)) = HASH_EMPTY;
+    } else {
+        SLOT_HASH(SLOT(impl, index)) = HASH_TOMBSTONE;
+        impl->tombstones ++;
     }
+
+    impl->count --;
 }
 
 void _ecs_hashmap_remove(
@@ -174,7 +282,8 @@ ecs_hashmap_iter_t ecs_hashmap_iter(
     ecs_hashmap_t map)
 {
     return (ecs_hashmap_iter_t){
-        .it = ecs_map_iter(map.impl)
+        .impl = map.impl,
+        .index = -1
     };
 }
 
@@ -184,19 +293,29 @@ void* _ecs_hashmap_next(
     void *key_out,
     ecs_size_t value_size)
 {
-    int32_t index = ++ it->index;
-    ecs_hm_bucket_t *bucket = it->bucket;
-    while (!bucket || it->index >= ecs_vector_count(bucket->keys)) {
-        bucket = it->bucket = ecs_map_next(&it->it, ecs_hm_bucket_t, NULL);
-        if (!bucket) {
+    const ecs_hm_slots_t *impl = it->impl;
+    ecs_assert(!key_size || key_size == impl->key_size,
+        ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(value_size == impl->value_size, ECS_INVALID_PARAMETER, NULL);
+    (void)key_size;
+    (void)value_size;
+
+    int32_t index = it->index, slot_count = impl->slot_count;
+    void *slot;
+
+    do {
+        if (++ index >= slot_count) {
+            it->index = slot_count;
             return NULL;
         }
-        index = it->index = 0;
-    }
+        slot = SLOT(impl, index);
+    } while (SLOT_HASH(slot) <= HASH_TOMBSTONE);
+
+    it->index = index;
 
     if (key_out) {
-        *(void**)key_out = ecs_vector_get_t(bucket->keys, key_size, 8, index);
+        *(void**)key_out = SLOT_KEY(slot);
     }
-    
-    return ecs_vector_get_t(bucket->values, value_size, 8, index);
+
+    return SLOT_VALUE(impl, slot);
 }
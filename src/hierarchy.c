@@ -3,6 +3,10 @@
 
 #define ECS_NAME_BUFFER_LENGTH (64)
 
+/* Maximum number of entities that can wait to be added to a name index. When
+ * more entities are waiting, the indices are rebuilt on the next lookup. */
+#define ECS_NAME_INDEX_MAX_PENDING (4096)
+
 static
 bool path_append(
     const ecs_world_t *world, 
@@ -161,26 +165,352 @@ ecs_entity_t find_child_in_table(
 }
 
 static
-ecs_entity_t find_child(
+ecs_entity_t scan_symbol(
     const ecs_world_t *world,
-    ecs_entity_t parent,
     const char *symbol)
-{        
+{
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INTERNAL_ERROR, NULL);
 
-    (void)parent;
-    
-    ecs_sparse_each(world->store.tables, ecs_table_t, table, {
-        ecs_entity_t result = find_child_in_table(table, NULL, symbol);
+    ecs_id_record_t *r = ecs_get_id_record(world, ecs_id(EcsName));
+    if (r && r->table_index) {
+        ecs_map_iter_t it = ecs_map_iter(r->table_index);
+        ecs_table_record_t *tr;
+        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
+            ecs_entity_t result = find_child_in_table(tr->table, NULL, symbol);
+            if (result) {
+                return result;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static
+ecs_entity_t scan_scope(
+    const ecs_id_record_t *r,
+    const char *name)
+{
+    ecs_map_iter_t it = ecs_map_iter(r->table_index);
+    ecs_table_record_t *tr;
+    while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
+        ecs_entity_t result = find_child_in_table(tr->table, name, NULL);
         if (result) {
             return result;
         }
-    });    
+    }
 
     return 0;
 }
 
+/* -- Name index --
+ *
+ * Scopes have a map from name hash to entity, which is stored on the id record
+ * of (ChildOf, parent). The world has a map from symbol hash to entity. Both
+ * are built when they are first looked up in, after which entities of which
+ * the name or scope may have changed are added to a pending list by the code
+ * that changes them. The pending list is processed before the next lookup.
+ *
+ * Entries are not removed when an entity is deleted, renamed or moved to
+ * another scope. Instead, the entry is checked when it is found, and if it is
+ * no longer valid the scope (or world) is scanned, which also repairs the
+ * entry. Since an index can only return a stale entity, and not miss one that
+ * is in the pending list, a hash collision also resolves through the scan. */
+
+static
+uint64_t name_hash(
+    const char *name)
+{
+    uint64_t hash;
+    ecs_hash(name, ecs_os_strlen(name), &hash);
+    return hash;
+}
+
+static
+void index_table_names(
+    ecs_map_t *index,
+    const ecs_table_t *table,
+    bool symbol)
+{
+    int32_t name_index = ecs_type_index_of(table->type, ecs_id(EcsName));
+    if (name_index == -1) {
+        return;
+    }
+
+    ecs_data_t *data = ecs_table_get_data(table);
+    if (!data || !data->columns) {
+        return;
+    }
+
+    int32_t i, count = ecs_vector_count(data->entities);
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    EcsName *names = ecs_vector_first(data->columns[name_index].data, EcsName);
+
+    for (i = 0; i < count; i ++) {
+        const char *str = symbol ? names[i].symbol : names[i].value;
+        if (!str) {
+            continue;
+        }
+
+        /* If the name is not unique, the first match is returned, which is
+         * the same entity a scan would find. */
+        uint64_t hash = name_hash(str);
+        if (!ecs_map_get(index, ecs_entity_t, hash)) {
+            ecs_map_set(index, hash, &entities[i]);
+        }
+    }
+}
+
+static
+ecs_map_t* build_index(
+    const ecs_id_record_t *r,
+    bool symbol)
+{
+    ecs_map_t *index = ecs_map_new(ecs_entity_t, 0);
+
+    if (r && r->table_index) {
+        ecs_map_iter_t it = ecs_map_iter(r->table_index);
+        ecs_table_record_t *tr;
+        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
+            index_table_names(index, tr->table, symbol);
+        }
+    }
+
+    return index;
+}
+
+static
+void name_index_reset(
+    ecs_world_t *world)
+{
+    ecs_map_iter_t it = ecs_map_iter(world->id_index);
+    ecs_id_record_t *r;
+    while ((r = ecs_map_next(&it, ecs_id_record_t, NULL))) {
+        ecs_map_free(r->name_index);
+        r->name_index = NULL;
+    }
+
+    ecs_map_free(world->symbol_index);
+    world->symbol_index = NULL;
+    ecs_vector_clear(world->name_index_pending);
+    world->name_index_active = false;
+}
+
+static
+void name_index_flush(
+    ecs_world_t *world)
+{
+    int32_t i, count = ecs_vector_count(world->name_index_pending);
+    ecs_entity_t *entities = ecs_vector_first(
+        world->name_index_pending, ecs_entity_t);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = entities[i];
+        if (!ecs_is_alive(world, e)) {
+            continue;
+        }
+
+        const EcsName *name = ecs_get(world, e, EcsName);
+        if (!name) {
+            continue;
+        }
+
+        if (name->value) {
+            ecs_entity_t parent = ecs_get_object_w_id(world, e, EcsChildOf, 0);
+            ecs_id_record_t *r = ecs_get_id_record(
+                world, ecs_pair(EcsChildOf, parent));
+            if (r && r->name_index) {
+                ecs_map_set(r->name_index, name_hash(name->value), &e);
+            }
+        }
+
+        if (name->symbol && world->symbol_index) {
+            ecs_map_set(world->symbol_index, name_hash(name->symbol), &e);
+        }
+    }
+
+    ecs_vector_clear(world->name_index_pending);
+}
+
+/* Indices can only be built and repaired when the world is not readonly. When
+ * readonly, an index can be used as long as no entities are pending. */
+static
+bool name_index_usable(
+    const ecs_world_t *world,
+    const ecs_map_t *index)
+{
+    return index && !ecs_vector_count(world->name_index_pending);
+}
+
+static
+bool is_scope_entry(
+    const ecs_world_t *world,
+    const ecs_id_record_t *r,
+    ecs_entity_t e,
+    const char *name)
+{
+    if (!ecs_is_alive(world, e)) {
+        return false;
+    }
+
+    ecs_record_t *record = ecs_eis_get(world, e);
+    if (!record || !record->table) {
+        return false;
+    }
+
+    if (!ecs_map_get(r->table_index, ecs_table_record_t, record->table->id)) {
+        return false;
+    }
+
+    const EcsName *ptr = ecs_get(world, e, EcsName);
+    return ptr && ptr->value && !strcmp(ptr->value, name);
+}
+
+static
+ecs_entity_t find_child(
+    const ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *name)
+{
+    ecs_id_record_t *r = ecs_get_id_record(world, ecs_pair(EcsChildOf, parent));
+    if (!r || !r->table_index) {
+        return 0;
+    }
+
+    /* Numbers resolve to the first table in the scope with names */
+    if (is_number(name)) {
+        return scan_scope(r, name);
+    }
+
+    bool readonly = world->is_readonly;
+    if (!readonly) {
+        ecs_world_t *w = (ecs_world_t*)world;
+        name_index_flush(w);
+        if (!r->name_index) {
+            r->name_index = build_index(r, false);
+            w->name_index_active = true;
+        }
+    }
+
+    if (!name_index_usable(world, r->name_index)) {
+        return scan_scope(r, name);
+    }
+
+    uint64_t hash = name_hash(name);
+    ecs_entity_t *e = ecs_map_get(r->name_index, ecs_entity_t, hash);
+    if (e && is_scope_entry(world, r, *e, name)) {
+        return *e;
+    }
+
+    /* A name can be changed in place without notifying the index, as with
+     * ecs_get_mut without ecs_modified, so a miss is verified with a scan. */
+    ecs_entity_t result = scan_scope(r, name);
+    if (!readonly) {
+        if (result) {
+            ecs_map_set(r->name_index, hash, &result);
+        } else if (e) {
+            ecs_map_remove(r->name_index, hash);
+        }
+    }
+
+    return result;
+}
+
+static
+ecs_entity_t find_symbol(
+    const ecs_world_t *world,
+    const char *symbol)
+{
+    bool readonly = world->is_readonly;
+    if (!readonly) {
+        ecs_world_t *w = (ecs_world_t*)world;
+        name_index_flush(w);
+        if (!world->symbol_index) {
+            w->symbol_index = build_index(
+                ecs_get_id_record(world, ecs_id(EcsName)), true);
+            w->name_index_active = true;
+        }
+    }
+
+    if (!name_index_usable(world, world->symbol_index)) {
+        return scan_symbol(world, symbol);
+    }
+
+    uint64_t hash = name_hash(symbol);
+    ecs_entity_t *e = ecs_map_get(world->symbol_index, ecs_entity_t, hash);
+    if (e && ecs_is_alive(world, *e)) {
+        const EcsName *ptr = ecs_get(world, *e, EcsName);
+        if (ptr && ptr->symbol && !strcmp(ptr->symbol, symbol)) {
+            return *e;
+        }
+    }
+
+    /* Like names, symbols can be changed without notifying the index */
+    ecs_entity_t result = scan_symbol(world, symbol);
+    if (!readonly) {
+        if (result) {
+            ecs_map_set(world->symbol_index, hash, &result);
+        } else if (e) {
+            ecs_map_remove(world->symbol_index, hash);
+        }
+    }
+
+    return result;
+}
+
+void ecs_name_index_touch(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    if (!world->name_index_active) {
+        return;
+    }
+
+    /* If many entities changed since the last lookup, rebuilding the indices
+     * that are used is cheaper than keeping track of all the changes */
+    if (ecs_vector_count(world->name_index_pending) >= 
+        ECS_NAME_INDEX_MAX_PENDING) 
+    {
+        name_index_reset(world);
+        return;
+    }
+
+    ecs_entity_t *elem = ecs_vector_add(
+        &world->name_index_pending, ecs_entity_t);
+    *elem = entity;
+}
+
+void ecs_name_index_touch_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data)
+{
+    if (!world->name_index_active || !data) {
+        return;
+    }
+
+    if (ecs_type_index_of(table->type, ecs_id(EcsName)) == -1) {
+        return;
+    }
+
+    int32_t i, count = ecs_vector_count(data->entities);
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    for (i = 0; i < count; i ++) {
+        ecs_name_index_touch(world, entities[i]);
+    }
+}
+
+void ecs_name_index_fini(
+    ecs_world_t *world)
+{
+    ecs_map_free(world->symbol_index);
+    ecs_vector_free(world->name_index_pending);
+    world->symbol_index = NULL;
+    world->name_index_pending = NULL;
+    world->name_index_active = false;
+}
+
 static
 bool is_sep(
     const char **ptr,
@@ -298,21 +628,7 @@ ecs_entity_t ecs_lookup_child(
 {
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
     world = ecs_get_world(world);
-    ecs_entity_t result = 0;
-
-    ecs_id_record_t *r = ecs_get_id_record(world, ecs_pair(EcsChildOf, parent));
-    if (r && r->table_index) {        
-        ecs_map_iter_t it = ecs_map_iter(r->table_index);
-        ecs_table_record_t *tr;
-        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
-            result = find_child_in_table(tr->table, name, NULL);
-            if (result) {
-                return result;
-            }            
-        }
-    }
-
-    return result;
+    return find_child(world, parent, name);
 }
 
 ecs_entity_t ecs_lookup(
@@ -363,7 +679,7 @@ ecs_entity_t ecs_lookup_symbol(
         return name_to_id(name);
     }   
     
-    return find_child(world, 0, name);
+    return find_symbol(world, name);
 }
 
 ecs_entity_t ecs_lookup_path_w_sep(
@@ -493,18 +809,12 @@ int32_t ecs_get_child_count(
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
     world = ecs_get_world(world);
 
-    int32_t count = 0;
-
     ecs_id_record_t *r = ecs_get_id_record(world, ecs_pair(EcsChildOf, parent));
-    if (r && r->table_index) {
-        ecs_map_iter_t it = ecs_map_iter(r->table_index);
-        ecs_table_record_t *tr;
-        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
-            count += ecs_table_count(tr->table);
-        }
+    if (r && r->parent) {
+        return r->parent->child_count;
     }
 
-    return count;
+    return 0;
 }
 
 ecs_iter_t ecs_scope_iter_w_filter(
@@ -519,9 +829,9 @@ ecs_iter_t ecs_scope_iter_w_filter(
     };
 
     ecs_id_record_t *r = ecs_get_id_record(world, ecs_pair(EcsChildOf, parent));
-    if (r && r->table_index) {
-        it.iter.parent.tables = ecs_map_iter(r->table_index);
-        it.table_count = ecs_map_count(r->table_index);
+    if (r && r->parent) {
+        it.iter.parent.parent = r->parent;
+        it.table_count = ecs_vector_count(r->parent->tables);
         if (filter) {
             it.iter.parent.filter = *filter;
         }
@@ -541,24 +851,26 @@ bool ecs_scope_next(
     ecs_iter_t *it)
 {
     ecs_scope_iter_t *iter = &it->iter.parent;
-    ecs_map_iter_t *tables = &iter->tables;
+    ecs_parent_record_t *parent = iter->parent;
+    if (!parent) {
+        return false;
+    }
+
+    /* The parent only stores non-empty tables, ordered by table id. Lookup
+     * the next table by id, so that tables that become empty or non-empty
+     * while iterating don't cause tables to be skipped. */
     ecs_filter_t filter = iter->filter;
-    ecs_table_record_t *tr;
-    while ((tr = ecs_map_next(tables, ecs_table_record_t, NULL))) {
-        ecs_table_t *table = tr->table;
-        ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    int32_t i = ecs_parent_table_lower_bound(parent, iter->next_table_id);
+    int32_t count = ecs_vector_count(parent->tables);
+    ecs_table_t **tables = ecs_vector_first(parent->tables, ecs_table_t*);
 
-        iter->index ++;
+    for (; i < count; i ++) {
+        ecs_table_t *table = tables[i];
+        ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+        iter->next_table_id = table->id + 1;
 
         ecs_data_t *data = ecs_table_get_data(table);
-        if (!data) {
-            continue;
-        }
-
-        it->count = ecs_table_count(table);
-        if (!it->count) {
-            continue;
-        }
+        ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
 
         if (filter.include || filter.exclude) {
             if (!ecs_table_match_filter(it->world, table, &filter)) {
@@ -75,6 +75,28 @@ bool get_table_column(
     return true;
 }
 
+/* Ids with sparse storage are not stored in a table column. Query iterators
+ * return these one entity at a time, so the pointer is looked up directly */
+static
+void* get_sparse_storage_ptr(
+    const ecs_iter_t *it,
+    int32_t column,
+    int32_t row)
+{
+    if (!it->query || !it->table->components || !it->count) {
+        return NULL;
+    }
+
+    const ecs_world_t *world = ecs_get_world(it->world);
+    ecs_sparse_t *storage = ecs_sparse_storage_get(
+        world, it->table->components[column - 1]);
+    if (!storage) {
+        return NULL;
+    }
+
+    return ecs_sparse_storage_get_ptr(storage, it->entities[row]);
+}
+
 static
 void* get_term(
     const ecs_iter_t *it,
@@ -89,7 +111,7 @@ void* get_term(
     }
 
     if (!get_table_column(it, column, &table_column)) {
-        return NULL;
+        return get_sparse_storage_ptr(it, column, row);
     }
 
     if (table_column < 0) {
@@ -3,46 +3,56 @@
 /* The ratio used to determine whether the map should rehash. If
  * (element_count * LOAD_FACTOR) > bucket_count, bucket count is increased. */
 #define LOAD_FACTOR (1.5f)
-#define KEY_SIZE (ECS_SIZEOF(ecs_map_key_t))
-#define GET_ELEM(array, elem_size, index) \
-    ECS_OFFSET(array, (elem_size) * (index))
-
-typedef struct ecs_bucket_t {
-    ecs_map_key_t *keys;    /* Array with keys */
-    void *payload;          /* Payload array */
-    int32_t count;          /* Number of elements in bucket */
-} ecs_bucket_t;
+#define HEADER_SIZE (ECS_SIZEOF(ecs_map_slot_t))
+#define GET_SLOT(slots, slot_size, index) \
+    ((ecs_map_slot_t*)ECS_OFFSET(slots, (slot_size) * (index)))
+#define GET_PAYLOAD(slot) \
+    ECS_OFFSET(slot, HEADER_SIZE)
+
+/* Slot header. The payload of an element is stored directly after the header,
+ * so that a lookup only touches the slots it probes. */
+typedef struct ecs_map_slot_t {
+    ecs_map_key_t key;
+    int32_t dist;           /* Distance to preferred slot + 1, 0 if empty */
+} ecs_map_slot_t;
 
 struct ecs_map_t {
-    ecs_bucket_t *buckets;
+    void *slots;            /* Array with slots (header + payload) */
     int32_t elem_size;
-    int32_t bucket_count;
-    int32_t count;
+    int32_t slot_size;      /* Size of header + aligned payload */
+    int32_t bucket_count;   /* Number of slots */
+    int32_t count;          /* Number of elements */
 };
 
-/* Get bucket count for number of elements */
+/* Get preferred slot for key. The lower bits of a key are used as is, so that
+ * sequential keys like entity and table ids are stored in consecutive slots.
+ * The upper bits are mixed in, so that keys that only differ in their upper
+ * bits (like pairs with the same object, or ids with a different generation)
+ * don't all end up in the same slot. */
 static
-int32_t get_bucket_count(
-    int32_t element_count)
+int32_t get_slot_id(
+    int32_t bucket_count,
+    ecs_map_key_t key)
 {
-    return ecs_next_pow_of_2((int32_t)((float)element_count * LOAD_FACTOR));
+    ecs_assert(bucket_count > 0, ECS_INTERNAL_ERROR, NULL);
+    uint32_t lo = (uint32_t)key;
+    uint32_t hi = (uint32_t)(key >> 32);
+    return (int32_t)((lo ^ (hi * 0x9E3779B9u)) & (uint32_t)(bucket_count - 1));
 }
 
-/* Get bucket index for provided map key */
+/* Get bucket count for number of elements */
 static
-int32_t get_bucket_id(
-    int32_t bucket_count,
-    ecs_map_key_t key) 
+int32_t get_bucket_count(
+    int32_t element_count)
 {
-    ecs_assert(bucket_count > 0, ECS_INTERNAL_ERROR, NULL);
-    int32_t result = (int32_t)(key & ((uint64_t)bucket_count - 1));
-    ecs_assert(result < INT32_MAX, ECS_INTERNAL_ERROR, NULL);
-    return result;
+    return ecs_next_pow_of_2((int32_t)((float)element_count * LOAD_FACTOR));
 }
 
-/* Get bucket for key */
+/* Find slot for key. Slots are kept ordered by the distance to their preferred
+ * slot (robin hood hashing), so a probe ends as soon as it finds an element
+ * that is closer to its preferred slot than the key would be. */
 static
-ecs_bucket_t* get_bucket(
+ecs_map_slot_t* find_slot(
     const ecs_map_t *map,
     ecs_map_key_t key)
 {
@@ -51,192 +61,115 @@ ecs_bucket_t* get_bucket(
         return NULL;
     }
 
-    int32_t bucket_id = get_bucket_id(bucket_count, key);
-    ecs_assert(bucket_id < bucket_count, ECS_INTERNAL_ERROR, NULL);
+    void *slots = map->slots;
+    int32_t slot_size = map->slot_size;
+    int32_t mask = bucket_count - 1;
+    int32_t index = get_slot_id(bucket_count, key);
+    int32_t dist;
 
-    return &map->buckets[bucket_id];
-}
-
-/* Ensure that map has at least new_count buckets */
-static
-void ensure_buckets(
-    ecs_map_t *map,
-    int32_t new_count)
-{
-    int32_t bucket_count = map->bucket_count;
-    new_count = ecs_next_pow_of_2(new_count);
-    if (new_count && new_count > bucket_count) {
-        map->buckets = ecs_os_realloc(map->buckets, new_count * ECS_SIZEOF(ecs_bucket_t));
-        map->bucket_count = new_count;
-
-        ecs_os_memset(
-            ECS_OFFSET(map->buckets, bucket_count * ECS_SIZEOF(ecs_bucket_t)), 
-            0, (new_count - bucket_count) * ECS_SIZEOF(ecs_bucket_t));
-    }
-}
+    for (dist = 1; ; dist ++) {
+        ecs_map_slot_t *slot = GET_SLOT(slots, slot_size, index);
+        if (slot->dist < dist) {
+            return NULL;
+        }
 
-/* Free contents of bucket */
-static
-void clear_bucket(
-    ecs_bucket_t *bucket)
-{
-    ecs_os_free(bucket->keys);
-    ecs_os_free(bucket->payload);
-    bucket->keys = NULL;
-    bucket->payload = NULL;
-    bucket->count = 0;
-}
+        if (slot->key == key) {
+            return slot;
+        }
 
-/* Clear all buckets */
-static
-void clear_buckets(
-    ecs_map_t *map)
-{
-    ecs_bucket_t *buckets = map->buckets;
-    int32_t i, count = map->bucket_count;
-    for (i = 0; i < count; i ++) {
-        clear_bucket(&buckets[i]);
+        index = (index + 1) & mask;
     }
-    ecs_os_free(buckets);
-    map->buckets = NULL;
-    map->bucket_count = 0;
 }
 
-/* Find or create bucket for specified key */
+/* Insert key that isn't yet in the map. The key is stored in the first slot
+ * that holds an element closer to its preferred slot. That element and the
+ * elements after it are shifted by one, up to the first empty slot. */
 static
-ecs_bucket_t* ensure_bucket(
+void* insert_slot(
     ecs_map_t *map,
     ecs_map_key_t key)
 {
-    if (!map->bucket_count) {
-        ensure_buckets(map, 2);
+    void *slots = map->slots;
+    int32_t slot_size = map->slot_size;
+    int32_t mask = map->bucket_count - 1;
+    int32_t index = get_slot_id(map->bucket_count, key);
+    int32_t dist = 1;
+
+    ecs_map_slot_t *slot = GET_SLOT(slots, slot_size, index);
+    while (slot->dist >= dist) {
+        index = (index + 1) & mask;
+        slot = GET_SLOT(slots, slot_size, index);
+        dist ++;
     }
 
-    int32_t bucket_id = get_bucket_id(map->bucket_count, key);
-    ecs_assert(bucket_id >= 0, ECS_INTERNAL_ERROR, NULL);
-    return &map->buckets[bucket_id];
-}
-
-/* Add element to bucket */
-static
-int32_t add_to_bucket(
-    ecs_bucket_t *bucket,
-    ecs_size_t elem_size,
-    ecs_map_key_t key,
-    const void *payload)
-{
-    int32_t index = bucket->count ++;
-    int32_t bucket_count = index + 1;
-
-    bucket->keys = ecs_os_realloc(bucket->keys, KEY_SIZE * bucket_count);
-    bucket->payload = ecs_os_realloc(bucket->payload, elem_size * bucket_count);
-    bucket->keys[index] = key;
-
-    if (payload) {
-        void *elem = GET_ELEM(bucket->payload, elem_size, index);
-        ecs_os_memcpy(elem, payload, elem_size);
+    if (slot->dist) {
+        int32_t empty = index;
+        do {
+            empty = (empty + 1) & mask;
+        } while (GET_SLOT(slots, slot_size, empty)->dist);
+
+        while (empty != index) {
+            int32_t prev = (empty - 1) & mask;
+            ecs_map_slot_t *dst = GET_SLOT(slots, slot_size, empty);
+            ecs_map_slot_t *src = GET_SLOT(slots, slot_size, prev);
+            ecs_os_memcpy(dst, src, slot_size);
+            dst->dist ++;
+            empty = prev;
+        }
     }
 
-    return index;
-}
-
-/*  Remove element from bucket */
-static
-void remove_from_bucket(
-    ecs_bucket_t *bucket,
-    ecs_size_t elem_size,
-    ecs_map_key_t key,
-    int32_t index)
-{
-    (void)key;
-
-    ecs_assert(bucket->count != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(index < bucket->count, ECS_INTERNAL_ERROR, NULL);
-    
-    int32_t bucket_count = -- bucket->count;
-
-    if (index != bucket->count) {
-        ecs_assert(key == bucket->keys[index], ECS_INTERNAL_ERROR, NULL);
-        bucket->keys[index] = bucket->keys[bucket_count];
-
-        ecs_map_key_t *elem = GET_ELEM(bucket->payload, elem_size, index);
-        ecs_map_key_t *last_elem = GET_ELEM(bucket->payload, elem_size, bucket->count);
+    slot->key = key;
+    slot->dist = dist;
+    map->count ++;
 
-        ecs_os_memcpy(elem, last_elem, elem_size);
-    }
+    return GET_PAYLOAD(slot);
 }
 
-/* Get payload pointer for key from bucket */
-static
-void* get_from_bucket(
-    ecs_bucket_t *bucket,
-    ecs_map_key_t key,
-    ecs_size_t elem_size)
-{
-    ecs_map_key_t *keys = bucket->keys;
-    int32_t i, count = bucket->count;
-
-    for (i = 0; i < count; i ++) {
-        if (keys[i] == key) {
-            return GET_ELEM(bucket->payload, elem_size, i);
-        }
-    }
-    return NULL;
-}
-
-/* Grow number of buckets */
+/* Rehash map into new number of slots */
 static
 void rehash(
     ecs_map_t *map,
     int32_t bucket_count)
 {
-    ecs_assert(bucket_count != 0, ECS_INTERNAL_ERROR, NULL);
-    ecs_assert(bucket_count > map->bucket_count, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(bucket_count >= map->count, ECS_INTERNAL_ERROR, NULL);
 
+    void *old_slots = map->slots;
+    int32_t old_count = map->bucket_count;
+    int32_t slot_size = map->slot_size;
     ecs_size_t elem_size = map->elem_size;
 
-    ensure_buckets(map, bucket_count);
-
-    ecs_bucket_t *buckets = map->buckets;
-    ecs_assert(buckets != NULL, ECS_INTERNAL_ERROR, NULL);
-    
-    int32_t bucket_id;
-
-    /* Iterate backwards as elements could otherwise be moved to existing
-        * buckets which could temporarily cause the number of elements in a
-        * bucket to exceed BUCKET_COUNT. */
-    for (bucket_id = bucket_count - 1; bucket_id >= 0; bucket_id --) {
-        ecs_bucket_t *bucket = &buckets[bucket_id];
-
-        int i, count = bucket->count;
-        ecs_map_key_t *key_array = bucket->keys;
-        void *payload_array = bucket->payload;
-
-        for (i = 0; i < count; i ++) {
-            ecs_map_key_t key = key_array[i];
-            void *elem = GET_ELEM(payload_array, elem_size, i);
-            int32_t new_bucket_id = get_bucket_id(bucket_count, key);
-
-            if (new_bucket_id != bucket_id) {
-                ecs_bucket_t *new_bucket = &buckets[new_bucket_id];
-
-                add_to_bucket(new_bucket, elem_size, key, elem);
-                remove_from_bucket(bucket, elem_size, key, i);
+    map->slots = ecs_os_calloc(slot_size * bucket_count);
+    ecs_assert(map->slots != NULL, ECS_OUT_OF_MEMORY, NULL);
+    map->bucket_count = bucket_count;
+    map->count = 0;
 
-                count --;
-                i --;
-            }
+    int32_t i;
+    for (i = 0; i < old_count; i ++) {
+        ecs_map_slot_t *slot = GET_SLOT(old_slots, slot_size, i);
+        if (slot->dist) {
+            void *payload = insert_slot(map, slot->key);
+            ecs_os_memcpy(payload, GET_PAYLOAD(slot), elem_size);
         }
+    }
 
-        if (!bucket->count) {
-            clear_bucket(bucket);
-        }
+    ecs_os_free(old_slots);
+}
+
+/* Make sure that the map can store element_count elements without rehashing */
+static
+void reserve(
+    ecs_map_t *map,
+    int32_t element_count)
+{
+    int32_t bucket_count = get_bucket_count(element_count);
+    if (bucket_count > map->bucket_count) {
+        rehash(map, bucket_count);
     }
 }
 
 ecs_map_t* _ecs_map_new(
     ecs_size_t elem_size,
-    ecs_size_t alignment, 
+    ecs_size_t alignment,
     int32_t element_count)
 {
     (void)alignment;
@@ -244,12 +177,15 @@ ecs_map_t* _ecs_map_new(
     ecs_map_t *result = ecs_os_calloc(ECS_SIZEOF(ecs_map_t) * 1);
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
 
-    int32_t bucket_count = get_bucket_count(element_count);
-
-    result->count = 0;
     result->elem_size = elem_size;
+    result->slot_size = HEADER_SIZE;
+    if (elem_size) {
+        result->slot_size += ECS_ALIGN(elem_size, ECS_SIZEOF(ecs_map_key_t));
+    }
 
-    ensure_buckets(result, bucket_count);
+    if (element_count) {
+        reserve(result, element_count);
+    }
 
     return result;
 }
@@ -258,7 +194,7 @@ void ecs_map_free(
     ecs_map_t *map)
 {
     if (map) {
-        clear_buckets(map);
+        ecs_map_clear(map);
         ecs_os_free(map);
     }
 }
@@ -276,12 +212,12 @@ void* _ecs_map_get(
 
     ecs_assert(elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t * bucket = get_bucket(map, key);
-    if (!bucket) {
+    ecs_map_slot_t *slot = find_slot(map, key);
+    if (!slot) {
         return NULL;
     }
 
-    return get_from_bucket(bucket, key, elem_size);
+    return GET_PAYLOAD(slot);
 }
 
 void* _ecs_map_get_ptr(
@@ -321,30 +257,20 @@ void* _ecs_map_set(
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t *bucket = ensure_bucket(map, key);
-    ecs_assert(bucket != NULL, ECS_INTERNAL_ERROR, NULL);
-
-    void *elem = get_from_bucket(bucket, key, elem_size);
-    if (!elem) {
-        int32_t index = add_to_bucket(bucket, elem_size, key, payload);
-        
-        int32_t map_count = ++map->count;
-        int32_t target_bucket_count = get_bucket_count(map_count);
-        int32_t map_bucket_count = map->bucket_count;
-
-        if (target_bucket_count > map_bucket_count) {
-            rehash(map, target_bucket_count);
-            bucket = ensure_bucket(map, key);
-            return get_from_bucket(bucket, key, elem_size);
-        } else {
-            return GET_ELEM(bucket->payload, elem_size, index);
-        }       
+    void *elem;
+    ecs_map_slot_t *slot = find_slot(map, key);
+    if (slot) {
+        elem = GET_PAYLOAD(slot);
     } else {
-        if (payload) {
-            ecs_os_memcpy(elem, payload, elem_size);
-        }
-        return elem;
+        reserve(map, map->count + 1);
+        elem = insert_slot(map, key);
     }
+
+    if (payload) {
+        ecs_os_memcpy(elem, payload, elem_size);
+    }
+
+    return elem;
 }
 
 void ecs_map_remove(
@@ -353,18 +279,35 @@ void ecs_map_remove(
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_bucket_t * bucket = get_bucket(map, key);
-    if (!bucket) {
+    ecs_map_slot_t *slot = find_slot(map, key);
+    if (!slot) {
         return;
     }
 
-    int32_t i, bucket_count = bucket->count;
-    for (i = 0; i < bucket_count; i ++) {
-        if (bucket->keys[i] == key) {
-            remove_from_bucket(bucket, map->elem_size, key, i);
-            map->count --;
+    /* Shift back elements that are not in their preferred slot, so that no
+     * probe passes an empty slot. Elements in their preferred slot, which is
+     * where sequential keys usually are, are not moved. */
+    void *slots = map->slots;
+    int32_t slot_size = map->slot_size;
+    int32_t mask = map->bucket_count - 1;
+    int32_t index = (int32_t)(((uintptr_t)slot - (uintptr_t)slots) /
+        (uintptr_t)slot_size);
+
+    for (;;) {
+        int32_t next = (index + 1) & mask;
+        ecs_map_slot_t *next_slot = GET_SLOT(slots, slot_size, next);
+        if (next_slot->dist <= 1) {
+            break;
         }
-    } 
+
+        ecs_os_memcpy(slot, next_slot, slot_size);
+        slot->dist --;
+        slot = next_slot;
+        index = next;
+    }
+
+    slot->dist = 0;
+    map->count --;
 }
 
 int32_t ecs_map_count(
@@ -383,7 +326,9 @@ void ecs_map_clear(
     ecs_map_t *map)
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
-    clear_buckets(map);
+    ecs_os_free(map->slots);
+    map->slots = NULL;
+    map->bucket_count = 0;
     map->count = 0;
 }
 
@@ -392,9 +337,7 @@ ecs_map_iter_t ecs_map_iter(
 {
     return (ecs_map_iter_t){
         .map = map,
-        .bucket = NULL,
-        .bucket_index = 0,
-        .element_index = 0
+        .index = 0
     };
 }
 
@@ -407,42 +350,29 @@ void* _ecs_map_next(
     if (!map) {
         return NULL;
     }
-    
+
     ecs_assert(!elem_size || elem_size == map->elem_size, ECS_INVALID_PARAMETER, NULL);
- 
-    ecs_bucket_t *bucket = iter->bucket;
-    int32_t element_index = iter->element_index;
-    elem_size = map->elem_size;
-
-    do {
-        if (!bucket) {
-            int32_t bucket_index = iter->bucket_index;
-            ecs_bucket_t *buckets = map->buckets;
-            if (bucket_index < map->bucket_count) {
-                bucket = &buckets[bucket_index];
-                iter->bucket = bucket;
-
-                element_index = 0;
-                iter->element_index = 0;
-            } else {
-                return NULL;
+
+    void *slots = map->slots;
+    int32_t slot_size = map->slot_size;
+    int32_t index, bucket_count = map->bucket_count;
+
+    for (index = iter->index; index < bucket_count; index ++) {
+        ecs_map_slot_t *slot = GET_SLOT(slots, slot_size, index);
+        if (slot->dist) {
+            iter->index = index + 1;
+
+            if (key_out) {
+                *key_out = slot->key;
             }
-        }
 
-        if (element_index < bucket->count) {
-            iter->element_index = element_index + 1;
-            break;
-        } else {
-            bucket = NULL;
-            iter->bucket_index ++;
+            return GET_PAYLOAD(slot);
         }
-    } while (true);
-    
-    if (key_out) {
-        *key_out = bucket->keys[element_index];
     }
 
-    return GET_ELEM(bucket->payload, elem_size, element_index);
+    iter->index = bucket_count;
+
+    return NULL;
 }
 
 void* _ecs_map_next_ptr(
@@ -458,32 +388,25 @@ void* _ecs_map_next_ptr(
 }
 
 void ecs_map_grow(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t element_count)
 {
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
-    int32_t target_count = map->count + element_count;
-    int32_t bucket_count = get_bucket_count(target_count);
-
-    if (bucket_count > map->bucket_count) {
-        rehash(map, bucket_count);
-    }
+    reserve(map, map->count + element_count);
 }
 
 void ecs_map_set_size(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t element_count)
-{    
+{
     ecs_assert(map != NULL, ECS_INVALID_PARAMETER, NULL);
-    int32_t bucket_count = get_bucket_count(element_count);
-
-    if (bucket_count) {
-        rehash(map, bucket_count);
+    if (element_count) {
+        reserve(map, element_count);
     }
 }
 
 void ecs_map_memory(
-    ecs_map_t *map, 
+    ecs_map_t *map,
     int32_t *allocd,
     int32_t *used)
 {
@@ -495,14 +418,6 @@ void ecs_map_memory(
 
     if (allocd) {
         *allocd += ECS_SIZEOF(ecs_map_t);
-
-        int i, bucket_count = map->bucket_count;
-        for (i = 0; i < bucket_count; i ++) {
-            ecs_bucket_t *bucket = &map->buckets[i];
-            *allocd += KEY_SIZE * bucket->count;
-            *allocd += map->elem_size * bucket->count;
-        }
-
-        *allocd += ECS_SIZEOF(ecs_bucket_t) * bucket_count;
+        *allocd += map->bucket_count * map->slot_size;
     }
 }
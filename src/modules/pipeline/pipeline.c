@@ -650,6 +650,8 @@ void ecs_deactivate_systems(
 
     /* Iterate over all systems, add EcsInvalid tag if queries aren't matched
      * with any tables */
+    ecs_world_deactivate_tables(world);
+
     ecs_iter_t it = ecs_query_iter(pq->build_query);
 
     /* Make sure that we defer adding the inactive tags until after iterating
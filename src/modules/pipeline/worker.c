@@ -298,6 +298,7 @@ void ecs_set_threads(
             if (ecs_stop_threads(world)) {
                 ecs_os_cond_free(world->worker_cond);
                 ecs_os_cond_free(world->sync_cond);
+                ecs_os_cond_free(world->level_cond);
                 ecs_os_mutex_free(world->sync_mutex);
             }
         }
@@ -306,6 +307,7 @@ void ecs_set_threads(
         if (threads > 1) {
             world->worker_cond = ecs_os_cond_new();
             world->sync_cond = ecs_os_cond_new();
+            world->level_cond = ecs_os_cond_new();
             world->sync_mutex = ecs_os_mutex_new();
             start_workers(world, threads);
         }
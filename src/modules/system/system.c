@@ -215,6 +215,8 @@ void ecs_enable_system(
         return;
     }
 
+    ecs_query_deactivate_tables(world, query);
+
     if (ecs_vector_count(query->tables)) {
         /* Only (de)activate system if it has non-empty tables. */
         ecs_system_activate(world, system, enabled, system_data);
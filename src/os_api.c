@@ -1,5 +1,17 @@
+/* Expose MAP_ANON and madvise, which are not part of POSIX */
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#elif defined(__APPLE__) && !defined(_DARWIN_C_SOURCE)
+#define _DARWIN_C_SOURCE
+#endif
+
 #include "private_api.h"
 
+#if defined(ECS_OS_LINUX) || defined(ECS_OS_DARWIN)
+#include <sys/mman.h>
+#define ECS_OS_HAS_MMAN
+#endif
+
 void ecs_os_api_impl(ecs_os_api_t *api);
 
 static bool ecs_os_api_initialized = false;
@@ -168,6 +180,49 @@ char* ecs_os_api_strdup(const char *str) {
     }
 }
 
+#ifdef ECS_OS_HAS_MMAN
+/* Don't reserve swap space, as most of a reserved range is never written to */
+#ifdef MAP_NORESERVE
+#define ECS_VM_FLAGS (MAP_PRIVATE | MAP_ANON | MAP_NORESERVE)
+#else
+#define ECS_VM_FLAGS (MAP_PRIVATE | MAP_ANON)
+#endif
+
+static
+void* ecs_os_api_vm_reserve(size_t size, bool huge_pages) {
+    void *result = mmap(
+        NULL, size, PROT_READ | PROT_WRITE, ECS_VM_FLAGS, -1, 0);
+    if (result == MAP_FAILED) {
+        return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (huge_pages) {
+        madvise(result, size, MADV_HUGEPAGE);
+    }
+#else
+    (void)huge_pages;
+#endif
+
+    return result;
+}
+
+static
+void ecs_os_api_vm_release(void *ptr, size_t size) {
+    munmap(ptr, size);
+}
+
+static
+void ecs_os_api_vm_reset(void *ptr, size_t size) {
+#ifdef ECS_OS_LINUX
+    /* On Linux, private anonymous pages read as zero after MADV_DONTNEED */
+    madvise(ptr, size, MADV_DONTNEED);
+#else
+    mmap(ptr, size, PROT_READ | PROT_WRITE, ECS_VM_FLAGS | MAP_FIXED, -1, 0);
+#endif
+}
+#endif
+
 /* Replace dots with underscores */
 static
 char *module_file_base(const char *module, char sep) {
@@ -240,6 +295,13 @@ void ecs_os_set_api_defaults(void)
     /* Strings */
     ecs_os_api.strdup_ = ecs_os_api_strdup;
 
+    /* Virtual memory */
+#ifdef ECS_OS_HAS_MMAN
+    ecs_os_api.vm_reserve_ = ecs_os_api_vm_reserve;
+    ecs_os_api.vm_release_ = ecs_os_api_vm_release;
+    ecs_os_api.vm_reset_ = ecs_os_api_vm_reset;
+#endif
+
     /* Time */
     ecs_os_api.sleep_ = ecs_os_time_sleep;
     ecs_os_api.get_time_ = ecs_os_gettime;
@@ -270,6 +332,13 @@ bool ecs_os_has_heap(void) {
         (ecs_os_api.free_ != NULL);
 }
 
+bool ecs_os_has_vm(void) {
+    return 
+        (ecs_os_api.vm_reserve_ != NULL) &&
+        (ecs_os_api.vm_release_ != NULL) &&
+        (ecs_os_api.vm_reset_ != NULL);
+}
+
 bool ecs_os_has_threading(void) {
     return
         (ecs_os_api.mutex_new_ != NULL) &&
@@ -54,13 +54,20 @@ bool ecs_get_info(
     ecs_entity_t entity,
     ecs_entity_info_t *info);
 
+/* Get component that entities in table inherit from a base. Returns NULL if
+ * none of the bases of the table have the component. */
+void* ecs_get_base_component(
+    const ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_id_t id);
+
 void ecs_run_monitors(
     ecs_world_t *world, 
     ecs_table_t *dst_table,
-    ecs_vector_t *v_dst_monitors, 
+    ecs_small_vector_t *v_dst_monitors, 
     int32_t dst_row, 
     int32_t count, 
-    ecs_vector_t *v_src_monitors);
+    ecs_small_vector_t *v_src_monitors);
 
 void ecs_register_name(
     ecs_world_t *world,
@@ -103,6 +110,7 @@ void ecs_eval_component_monitors(
 
 void ecs_monitor_mark_dirty(
     ecs_world_t *world,
+    ecs_entity_t entity,
     ecs_entity_t relation,
     ecs_entity_t id);
 
@@ -138,7 +146,7 @@ ecs_id_record_t* ecs_get_id_record(
     ecs_id_t id);
 
 void ecs_clear_id_record(
-    const ecs_world_t *world,
+    ecs_world_t *world,
     ecs_id_t id);
 
 void ecs_triggers_notify(
@@ -150,6 +158,9 @@ void ecs_triggers_notify(
     int32_t row,
     int32_t count);
 
+void ecs_table_clear_triggers(
+    ecs_table_t *table);
+
 ecs_map_t* ecs_triggers_get(
     const ecs_world_t *world,
     ecs_id_t id,
@@ -163,6 +174,76 @@ void ecs_observer_fini(
     ecs_world_t *world,
     ecs_observer_t *observer);
 
+////////////////////////////////////////////////////////////////////////////////
+//// Sparse storage API
+////////////////////////////////////////////////////////////////////////////////
+
+/* Create sparse storage for id */
+void ecs_sparse_storage_init(
+    ecs_world_t *world,
+    ecs_id_t id);
+
+/* Free sparse storage for id (invokes destructors) */
+void ecs_sparse_storage_fini(
+    ecs_world_t *world,
+    ecs_id_t id,
+    ecs_id_record_t *idr);
+
+/* Free sparse storage for all ids */
+void ecs_sparse_storage_fini_all(
+    ecs_world_t *world);
+
+/* Get sparse storage for id. Returns NULL if id is stored in tables */
+ecs_sparse_t* ecs_sparse_storage_get(
+    const ecs_world_t *world,
+    ecs_id_t id);
+
+/* Get value for entity from storage, NULL if entity doesn't have it */
+void* ecs_sparse_storage_get_ptr(
+    ecs_sparse_t *storage,
+    ecs_entity_t entity);
+
+/* Get or add value for entity to storage */
+void* ecs_sparse_storage_ensure(
+    ecs_world_t *world,
+    ecs_sparse_t *storage,
+    ecs_id_t id,
+    ecs_entity_t entity,
+    bool construct,
+    bool *is_added);
+
+/* Remove value for entity from storage (invokes destructor) */
+bool ecs_sparse_storage_remove(
+    ecs_world_t *world,
+    ecs_sparse_t *storage,
+    ecs_id_t id,
+    ecs_entity_t entity);
+
+/* Remove entity from all sparse storages */
+void ecs_sparse_storage_clear(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
+////////////////////////////////////////////////////////////////////////////////
+//// Name index API
+////////////////////////////////////////////////////////////////////////////////
+
+/* Signal that the name, symbol or scope of an entity may have changed. Has no
+ * effect if no name or symbol index has been built. */
+void ecs_name_index_touch(
+    ecs_world_t *world,
+    ecs_entity_t entity);
+
+/* Signal that the names of all entities in a table may have changed */
+void ecs_name_index_touch_table(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data);
+
+/* Free name and symbol indices */
+void ecs_name_index_fini(
+    ecs_world_t *world);
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Stage API
 ////////////////////////////////////////////////////////////////////////////////
@@ -375,6 +456,26 @@ void ecs_table_activate(
     ecs_query_t *query,
     bool activate);
 
+/* Update child counts and table lists of the parents of entities in the table,
+ * when the number of entities in the table changes. */
+void ecs_table_update_parents(
+    ecs_table_t *table,
+    int32_t count);
+
+/* Register table with the parent of its entities */
+void ecs_table_add_parent(
+    ecs_table_t *table,
+    ecs_parent_record_t *parent);
+
+/* Find position of first table in parent's child tables with id >= table_id */
+int32_t ecs_parent_table_lower_bound(
+    const ecs_parent_record_t *parent,
+    uint64_t table_id);
+
+/* Remove table from its parents, and forget the parents */
+void ecs_table_clear_parents(
+    ecs_table_t *table);
+
 /* Clear all entities from a table. */
 void ecs_table_clear_entities(
     ecs_world_t *world,
@@ -417,6 +518,15 @@ void ecs_table_delete(
     int32_t index,
     bool destruct);
 
+/* Delete multiple entities from the table. Rows must be sorted and unique. */
+void ecs_table_delete_rows(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    const int32_t *rows,
+    int32_t row_count,
+    bool destruct);
+
 /* Move a row from one table to another */
 void ecs_table_move(
     ecs_world_t *world,
@@ -446,6 +556,18 @@ void ecs_table_set_size(
     ecs_data_t *data,
     int32_t count);
 
+/* Grow table storage to exactly the provided number of rows */
+void ecs_table_reserve(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t size);
+
+/* Shrink table storage to the number of rows. Returns the bytes released. */
+int64_t ecs_table_compact(
+    ecs_world_t *world,
+    ecs_table_t *table);
+
 /* Match table with filter */
 bool ecs_table_match_filter(
     const ecs_world_t *world,
@@ -580,6 +702,15 @@ void ecs_query_notify(
     ecs_query_t *query,
     ecs_query_event_t *event);
 
+/* Move tables that became empty to the list of empty tables of the query */
+void ecs_query_deactivate_tables(
+    ecs_world_t *world,
+    ecs_query_t *query);
+
+/* Same as ecs_query_deactivate_tables, for all queries in the world */
+void ecs_world_deactivate_tables(
+    ecs_world_t *world);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Time API
@@ -45,6 +45,10 @@
  * Increasing this value will increase consumption of stack space. */
 #define ECS_MAX_ADD_REMOVE (32)
 
+/* Number of prefab children in a table that can be instantiated without a heap
+ * allocation. Increasing this value will increase consumption of stack space. */
+#define ECS_MAX_CHILD_BUFFER (256)
+
 /** Type used for internal string hashmap */
 typedef struct ecs_string_t {
     char *value;
@@ -147,12 +151,28 @@ typedef struct ecs_table_leaf_t {
 #define EcsTableHasAddActions       (EcsTableHasBase | EcsTableHasSwitch | EcsTableHasCtors | EcsTableHasOnAdd | EcsTableHasOnSet | EcsTableHasMonitors)
 #define EcsTableHasRemoveActions    (EcsTableHasBase | EcsTableHasDtors | EcsTableHasOnRemove | EcsTableHasUnSet | EcsTableHasMonitors)
 
+/* Number of events for which tables cache triggers (OnAdd, OnRemove, OnSet,
+ * UnSet) */
+#define ECS_TRIGGER_EVENT_COUNT     (4)
+
+/* Number of triggers for an event that can be notified without allocating */
+#define ECS_TRIGGER_STACK_COUNT     (16)
+
 /** Edge used for traversing the table graph. */
 typedef struct ecs_edge_t {
     ecs_table_t *add;               /**< Edges traversed when adding */
     ecs_table_t *remove;            /**< Edges traversed when removing */
 } ecs_edge_t;
 
+/** Component resolved from a base entity, cached by tables with IsA pairs.
+ * The table of the base is stored so that the cached column can be validated
+ * against the record of the base before it is used. */
+typedef struct ecs_base_cache_elem_t {
+    ecs_entity_t base;              /**< Base that owns the component, or 0 */
+    ecs_table_t *table;             /**< Table of the base */
+    int32_t column;                 /**< Column of the component in table */
+} ecs_base_cache_elem_t;
+
 /** Quey matched with table with backref to query table administration.
  * This type is used to store a matched query together with the array index of
  * where the table is stored in the query administration. This type is used when
@@ -180,16 +200,27 @@ struct ecs_table_t {
     ecs_edge_t *lo_edges;            /**< Edges to other tables */
     ecs_map_t *hi_edges;
 
-    ecs_vector_t *queries;           /**< Queries matched with table */
-    ecs_vector_t *monitors;          /**< Monitor systems matched with table */
-    ecs_vector_t **on_set;           /**< OnSet systems, broken up by column */
-    ecs_vector_t *on_set_all;        /**< All OnSet systems */
-    ecs_vector_t *on_set_override;   /**< All OnSet systems with overrides */
-    ecs_vector_t *un_set_all;        /**< All UnSet systems */
+    ecs_small_vector_t queries;      /**< Queries matched with table */
+    ecs_small_vector_t monitors;     /**< Monitor systems matched with table */
+    ecs_small_vector_t *on_set;      /**< OnSet systems, broken up by column */
+    ecs_small_vector_t on_set_all;   /**< All OnSet systems */
+    ecs_small_vector_t on_set_override; /**< All OnSet systems w/overrides */
+    ecs_small_vector_t un_set_all;   /**< All UnSet systems */
+    ecs_small_vector_t *triggers[ECS_TRIGGER_EVENT_COUNT]; /**< Triggers per
+                                      * event, broken up by type index */
+    int32_t trigger_version;         /**< Trigger version of cached triggers */
+    ecs_map_t *base_cache;           /**< Components resolved from bases */
+    int32_t base_version;            /**< Base version of cached components */
+
+    ecs_small_vector_t parents;      /**< Parents of entities in table */
+    int32_t child_count;             /**< Entity count known to parents */
 
     int32_t *dirty_state;            /**< Keep track of changes in columns */
     int32_t alloc_count;             /**< Increases when columns are reallocd */
 
+    ecs_growth_policy_t growth_policy; /**< Table growth policy. If factor is
+                                        * 0 the world policy is used. */
+
     int32_t sw_column_count;
     int32_t sw_column_offset;
     int32_t bs_column_count;
@@ -211,11 +242,19 @@ typedef struct ecs_bitset_column_t {
     int32_t column_index;
 } ecs_bitset_column_t;
 
+/* Query term for an id with sparse storage */
+typedef struct ecs_sparse_storage_term_t {
+    ecs_id_t id;
+    ecs_oper_kind_t oper;
+} ecs_sparse_storage_term_t;
+
 /** Type containing data for a table matched with a query. */
 typedef struct ecs_matched_table_t {
     ecs_iter_table_t iter_data;    /**< Precomputed data for iterators */
-    ecs_vector_t *sparse_columns;  /**< Column ids of sparse columns */
-    ecs_vector_t *bitset_columns;  /**< Column ids with disabled flags */
+    ecs_small_vector_t sparse_columns; /**< Column ids of sparse columns */
+    ecs_small_vector_t bitset_columns; /**< Column ids w/disabled flags */
+    ecs_vector_t *sparse_storage;  /**< Terms for ids with sparse storage */
+    bool sparse_storage_data;      /**< Does sparse storage term have data */
     int32_t *monitor;              /**< Used to monitor table for changes */
     int32_t rank;                  /**< Rank used to sort tables */
 } ecs_matched_table_t;
@@ -234,8 +273,12 @@ typedef struct ecs_matched_table_t {
  * query matches pairs, a table can occupy multiple indices.
  */
 typedef struct ecs_table_indices_t {
-    int32_t *indices; /* If indices are negative, table is in empty list */
-    int32_t count;
+    ecs_small_vector_t indices; /* vector<int32_t>. If indices are negative,
+                                 * table is in empty list */
+    bool deactivate;            /* Table became empty, deactivation of the
+                                 * table is pending */
+    bool queued;                /* Table id is in the list of tables with a
+                                 * pending deactivation */
 } ecs_table_indices_t;
 
 /** Type storing an entity range within a table.
@@ -261,6 +304,8 @@ typedef struct ecs_table_slice_t {
 #define EcsQueryIsOrphaned (512)     /* Is subquery orphaned */
 #define EcsQueryHasOutColumns (1024) /* Does query have out columns */
 #define EcsQueryHasOptional (2048)   /* Does query have optional columns */
+#define EcsQueryHasSubjects (4096)   /* Does query have terms w/fixed subject */
+#define EcsQueryIterSparse (8192)    /* Query is iterated from sparse storage */
 
 #define EcsQueryNoActivation (EcsQueryMonitor | EcsQueryOnSet | EcsQueryUnSet)
 
@@ -278,6 +323,7 @@ typedef struct ecs_query_event_t {
     ecs_query_eventkind_t kind;
     ecs_table_t *table;
     ecs_query_t *parent_query;
+    ecs_vector_t *tables;   /* Tables to rematch (all tables if NULL) */
 } ecs_query_event_t;
 
 /** Query that is automatically matched against active tables */
@@ -292,6 +338,10 @@ struct ecs_query_t {
     ecs_vector_t *tables;
     ecs_vector_t *empty_tables;
     ecs_map_t *table_indices;
+    ecs_vector_t *deactivated;      /* vector<uint64_t>, ids of tables with
+                                     * a pending deactivation */
+    int32_t deactivated_count;      /* Number of entries in tables that are
+                                     * pending deactivation */
 
     /* Handle to system (optional) */
     ecs_entity_t system;   
@@ -387,6 +437,9 @@ typedef struct ecs_op_t {
     } is;
 } ecs_op_t;
 
+/* Upper bound for the number of ids reserved for a single stage */
+#define ECS_MAX_STAGE_IDS (4096)
+
 /** A stage is a data structure in which delta's are stored until it is safe to
  * merge those delta's with the main world stage. A stage allows flecs systems
  * to arbitrarily add/remove/set components and create/delete entities while
@@ -412,6 +465,11 @@ struct ecs_stage_t {
     ecs_entity_t scope;            /* Entity of current scope */
     ecs_entity_t with;             /* Id to add by default to new entities */
 
+    /* Entity ids reserved for the stage, so that threads can create entities
+     * without contending on the world id counter. Refilled during merge. */
+    ecs_vector_t *id_block;        /* vector<ecs_entity_t> */
+    int32_t ids_created;           /* Ids created since last merge */
+
     /* Properties */
     bool auto_merge;               /* Should this stage automatically merge? */
     bool asynchronous;             /* Is stage asynchronous? (write only) */
@@ -432,6 +490,7 @@ typedef struct ecs_monitor_set_t {
 /* Relation monitors. TODO: implement generic monitor mechanism */
 typedef struct ecs_relation_monitor_t {
     ecs_map_t *monitor_sets; /* map<relation_id, ecs_monitor_set_t> */
+    ecs_vector_t *dirty_entities; /* Monitored entities that changed */
     bool is_dirty;          /* Should monitor sets be evaluated? */
 } ecs_relation_monitor_t;
 
@@ -443,6 +502,13 @@ typedef struct ecs_table_record_t {
     int32_t count;
 } ecs_table_record_t;
 
+/* Children of a parent. Stored on the (ChildOf, parent) id record, and 
+ * allocated separately so that tables can keep a pointer to it. */
+struct ecs_parent_record_t {
+    int32_t child_count;            /* Number of children */
+    ecs_vector_t *tables;           /* Non-empty tables with children */
+};
+
 /* Payload for id index which contains all datastructures for an id. */
 typedef struct ecs_id_record_t {
     /* All tables that contain the id */
@@ -450,6 +516,16 @@ typedef struct ecs_id_record_t {
 
     ecs_entity_t on_delete;         /* Cleanup action for removing id */
     ecs_entity_t on_delete_object;  /* Cleanup action for removing object */
+
+    /* Storage for ids that are not stored in tables (see EcsSparse) */
+    ecs_sparse_t *sparse;           /* sparse<entity, T> */
+
+    /* Name index for (ChildOf, parent) records. Built on the first lookup in
+     * the scope, entries are validated when they are looked up. */
+    ecs_map_t *name_index;          /* map<name_hash, entity> */
+
+    /* Children administration for (ChildOf, parent) records */
+    ecs_parent_record_t *parent;
 } ecs_id_record_t;
 
 typedef struct ecs_store_t {
@@ -464,6 +540,9 @@ typedef struct ecs_store_t {
 
     /* Root table */
     ecs_table_t root;
+
+    /* Ids that have sparse storage */
+    ecs_vector_t *sparse_ids; /* vector<ecs_id_t> */
 } ecs_store_t;
 
 /** Supporting type to store looked up or derived entity data */
@@ -503,6 +582,8 @@ struct ecs_world_t {
 
     ecs_map_t *id_index;         /* map<id, ecs_id_record_t> */
     ecs_map_t *id_triggers;      /* map<id, ecs_id_trigger_t> */
+    int32_t trigger_version;     /* Increases when triggers are (un)registered */
+    int32_t base_version;        /* Increases when watched entities change */
     ecs_sparse_t *type_info;     /* sparse<type_id, type_info_t> */
 
     /* Is entity range checking enabled? */
@@ -517,6 +598,7 @@ struct ecs_world_t {
     /* --  Storages for API objects -- */
 
     ecs_sparse_t *queries; /* sparse<query_id, ecs_query_t> */
+    bool tables_deactivated; /* Do queries have pending deactivations */
     ecs_sparse_t *triggers; /* sparse<query_id, ecs_trigger_t> */
     ecs_sparse_t *observers; /* sparse<query_id, ecs_observer_t> */
     
@@ -542,6 +624,10 @@ struct ecs_world_t {
     /* -- Lookup Indices -- */
 
     ecs_map_t *type_handles;          /* Handles to named types */
+    ecs_map_t *symbol_index;          /* map<symbol_hash, entity> */
+    ecs_vector_t *name_index_pending; /* Entities that may have a new name or
+                                       * scope since the last lookup */
+    bool name_index_active;           /* Is a name or symbol index built */
 
 
     /* -- Aliasses -- */
@@ -567,6 +653,9 @@ struct ecs_world_t {
     ecs_os_mutex_t sync_mutex;       /* Mutex for job_cond */
     int32_t workers_running;         /* Number of threads running */
     int32_t workers_waiting;         /* Number of workers waiting on sync */
+    ecs_os_cond_t level_cond;        /* Signal that cascade level is done */
+    int32_t level_waiting;           /* Number of workers done with level */
+    int32_t level_generation;        /* Increases when level is done */
 
 
     /* -- Time management -- */
@@ -581,6 +670,11 @@ struct ecs_world_t {
     ecs_world_info_t stats;
 
 
+    /* -- Storage settings -- */
+
+    ecs_growth_policy_t growth_policy; /* Default growth policy for tables */
+
+
     /* -- Settings from command line arguments -- */
 
     int arg_fps;
@@ -615,6 +709,7 @@ struct ecs_world_t {
     bool measure_system_time;     /* Time spent by each system */
     bool should_quit;             /* Did a system signal that app should quit */
     bool locking_enabled;         /* Lock world when in progress */ 
+    bool coalesce_on_set;         /* Coalesce OnSet events of deferred ops */
 
     void *context;               /* Application context */
     ecs_vector_t *fini_actions;  /* Callbacks to execute when world exits */
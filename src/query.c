@@ -107,14 +107,15 @@ void order_grouped_tables(
             ecs_table_indices_t *ti;
             while ((ti = ecs_map_next(&it, ecs_table_indices_t, NULL))) {
                 /* If table is registered, it must have at least one index */
-                int32_t count = ti->count;
-                ecs_assert(count > 0, ECS_INTERNAL_ERROR, NULL);
-                (void)count;
+                int32_t *indices = ecs_small_vector_first_t(
+                    &ti->indices, int32_t);
+                ecs_assert(indices != NULL, ECS_INTERNAL_ERROR, NULL);
 
                 /* Only active tables are reordered, so don't reset inactive 
-                 * tables */
-                if (ti->indices[0] >= 0) {
-                    ti->count = 0;
+                 * tables. Resetting the count keeps the storage, so adding
+                 * the indices back doesn't allocate. */
+                if (indices[0] >= 0) {
+                    ti->indices.count = 0;
                 }
             }
         }
@@ -139,8 +140,7 @@ void order_grouped_tables(
                     ecs_table_indices_t, table->iter_data.table->id);
 
                 ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
-                ti->indices[ti->count] = table_i;
-                ti->count ++;
+                *ecs_small_vector_add(&ti->indices, int32_t) = table_i;
             });
         }
     }
@@ -202,6 +202,115 @@ const char* query_name(
 
 #endif
 
+/* Return sparse storage if term matches an id that is not stored in tables */
+static
+ecs_sparse_t* term_sparse_storage(
+    const ecs_world_t *world,
+    ecs_term_t *term)
+{
+    ecs_oper_kind_t oper = term->oper;
+    if (oper != EcsAnd && oper != EcsNot && oper != EcsOptional) {
+        return NULL;
+    }
+
+    if (term->args[0].entity != EcsThis) {
+        return NULL;
+    }
+
+    return ecs_sparse_storage_get(world, term->id);
+}
+
+/* Does query have a term that requires an id that is not stored in tables */
+static
+bool has_sparse_and_term(
+    const ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_term_t *terms = query->filter.terms;
+    int32_t i, count = query->filter.term_count;
+    for (i = 0; i < count; i ++) {
+        ecs_term_t *term = &terms[i];
+        if (term->oper == EcsAnd && term_sparse_storage(world, term)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Test if the query can be iterated from sparse storage instead of from its
+ * tables. This is the case when sparse terms are the only terms that select
+ * entities, in which case iterating the smallest storage is cheaper than
+ * testing each entity in each matched table. */
+static
+bool can_iter_sparse(
+    const ecs_world_t *world,
+    ecs_query_t *query)
+{
+    if (!has_sparse_and_term(world, query)) {
+        return false;
+    }
+
+    /* The storage is iterated in insertion order, which doesn't work with
+     * sorted or grouped tables. Tables are looked up in the table index, which
+     * isn't populated for queries that don't activate tables. */
+    if (query->cascade_by || query->order_by || query->group_by || 
+        query->flags & (EcsQueryNoActivation | EcsQueryIsSubquery))
+    {
+        return false;
+    }
+
+    ecs_term_t *terms = query->filter.terms;
+    int32_t i, count = query->filter.term_count;
+    for (i = 0; i < count; i ++) {
+        ecs_term_t *term = &terms[i];
+        if (term->args[0].entity != EcsThis) {
+            continue;
+        }
+
+        /* Not terms are evaluated when matching tables. Other terms can
+         * require iterating entities per table (bitset and switch columns) */
+        if (term->oper != EcsNot && !term_sparse_storage(world, term)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Find the id of the smallest storage of the sparse terms of a query */
+static
+ecs_id_t smallest_sparse_term(
+    const ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_term_t *terms = query->filter.terms;
+    int32_t i, count = query->filter.term_count, smallest_count = 0;
+    ecs_id_t result = 0;
+
+    for (i = 0; i < count; i ++) {
+        ecs_term_t *term = &terms[i];
+        if (term->oper != EcsAnd || term->args[0].entity != EcsThis) {
+            continue;
+        }
+
+        /* If the storage was deleted the term matches nothing, which is
+         * handled by the iterator when it can't find the storage */
+        ecs_sparse_t *storage = ecs_sparse_storage_get(world, term->id);
+        if (!storage) {
+            return term->id;
+        }
+
+        int32_t storage_count = ecs_sparse_count(storage);
+        if (!result || storage_count < smallest_count) {
+            result = term->id;
+            smallest_count = storage_count;
+        }
+    }
+
+    return result;
+}
+
 static
 int get_comp_and_src(
     ecs_world_t *world,
@@ -271,9 +380,10 @@ int get_comp_and_src(
 
             /* Optional terms may not have the component. *From terms contain
              * the id of a type of which the contents must match, but the type
-             * itself does not need to match. */
+             * itself does not need to match. Ids with sparse storage are never
+             * part of the table type. */
             if (op == EcsOptional || op == EcsAndFrom || op == EcsOrFrom || 
-                op == EcsNotFrom) 
+                op == EcsNotFrom || term_sparse_storage(world, term)) 
             {
                 result = true;
             }
@@ -304,6 +414,28 @@ int get_comp_and_src(
     return t;
 }
 
+/* Get the record for a (wildcard) pair from the id index. The record stores
+ * the first column and the number of occurrences of the pair in the table, so
+ * that the table type doesn't have to be scanned. */
+static
+ecs_table_record_t* get_pair_record(
+    const ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_id_t pair)
+{
+    /* A pair without an object is matched as (relation, *) */
+    if (!ECS_PAIR_OBJECT(pair)) {
+        pair = ecs_pair(ECS_PAIR_RELATION(pair), EcsWildcard);
+    }
+
+    ecs_id_record_t *idr = ecs_get_id_record(world, pair);
+    if (!idr) {
+        return NULL;
+    }
+
+    return ecs_map_get(idr->table_index, ecs_table_record_t, table->id);
+}
+
 typedef struct pair_offset_t {
     int32_t index;
     int32_t count;
@@ -313,7 +445,8 @@ typedef struct pair_offset_t {
  * multiple times per table, by keeping an offset of the last found index */
 static
 int32_t get_pair_index(
-    ecs_type_t table_type,
+    const ecs_world_t *world,
+    const ecs_table_t *table,
     ecs_id_t pair,
     int32_t column_index,
     pair_offset_t *pair_offsets,
@@ -331,9 +464,20 @@ int32_t get_pair_index(
         result = pair_offsets[column_index].index - 1;
     } else {
         /* First time for this iteration that the pair index is resolved, look
-         * it up in the type. */
-        result = ecs_type_match(table_type, 
-            pair_offsets[column_index].index, pair);
+         * it up in the type. Skip to the first occurrence of the pair in the
+         * table, which is stored in the id index. */
+        ecs_table_record_t *tr = get_pair_record(world, table, pair);
+        if (!tr) {
+            result = -1;
+        } else {
+            int32_t start = pair_offsets[column_index].index;
+            if (start < tr->column) {
+                start = tr->column;
+            }
+
+            result = ecs_type_match(table->type, start, pair);
+        }
+
         pair_offsets[column_index].index = result + 1;
         pair_offsets[column_index].count = count;
     }
@@ -379,8 +523,8 @@ int32_t get_component_index(
 
                 /* Get index of pair. Start looking from the last pair index
                  * as this may not be the first instance of the pair. */
-                result = get_pair_index(
-                    table_type, component, column_index, pair_offsets, count);
+                result = get_pair_index(world, table, component, 
+                    column_index, pair_offsets, count);
                 
                 if (result != -1) {
                     /* If component of current column is a pair, get the actual 
@@ -413,7 +557,7 @@ int32_t get_component_index(
                      * pair is applied. First, find the component identifier 
                      *
                      * This behavior will be replaced by query variables. */
-                    result = get_pair_index(table_type, component, 
+                    result = get_pair_index(world, table, component, 
                         column_index, pair_offsets, count);
 
                     /* Type must have the pair, otherwise table would not have
@@ -527,15 +671,16 @@ bool is_column_wildcard_pair(
 
 static
 int32_t get_pair_count(
-    ecs_type_t type,
+    const ecs_world_t *world,
+    const ecs_table_t *table,
     ecs_entity_t pair)
 {
-    int32_t i = -1, result = 0;
-    while (-1 != (i = ecs_type_match(type, i + 1, pair))) {
-        result ++;
+    ecs_table_record_t *tr = get_pair_record(world, table, pair);
+    if (!tr) {
+        return 0;
     }
 
-    return result;
+    return tr->count;
 }
 
 /* For each pair that the query subscribes for, count the occurrences in the
@@ -544,8 +689,12 @@ int32_t get_pair_count(
 static
 int32_t count_pairs(
     const ecs_query_t *query,
-    ecs_type_t type)
+    const ecs_table_t *table)
 {
+    if (!table) {
+        return 0;
+    }
+
     ecs_term_t *terms = query->filter.terms;
     int32_t i, count = query->filter.term_count;
     int32_t first_count = 0, pair_count = 0;
@@ -553,7 +702,7 @@ int32_t count_pairs(
     for (i = 0; i < count; i ++) {
         ecs_term_t *term = &terms[i];
         if (is_column_wildcard_pair(term)) {
-            pair_count = get_pair_count(type, term->id);
+            pair_count = get_pair_count(query->world, table, term->id);
             if (!first_count) {
                 first_count = pair_count;
             } else {
@@ -606,7 +755,7 @@ void add_table(
         table_type = table->type;
     }
 
-    int32_t pair_cur = 0, pair_count = count_pairs(query, table_type);
+    int32_t pair_cur = 0, pair_count = count_pairs(query, table);
     
     /* If the query has pairs, we need to account for the fact that a table may
      * have multiple components to which the pair is applied, which means the
@@ -621,8 +770,7 @@ void add_table(
     }
 
     /* From here we recurse */
-    int32_t *table_indices = NULL;
-    int32_t table_indices_count = 0;
+    ecs_small_vector_t table_indices = {0};
     int32_t matched_table_index = 0;
     ecs_matched_table_t table_data;
     ecs_vector_t *references = NULL;
@@ -668,6 +816,35 @@ add_pair:
         /* Get actual component and component source for current column */
         t = get_comp_and_src(world, query, t, table_type, &component, &entity);
 
+        /* If the id is not stored in tables, entities are tested against the
+         * sparse storage while iterating */
+        if (term_sparse_storage(world, term)) {
+            ecs_sparse_storage_term_t *st = ecs_vector_add(
+                &table_data.sparse_storage, ecs_sparse_storage_term_t);
+            st->id = term->id;
+            st->oper = op;
+
+            if (op != EcsNot) {
+                ecs_entity_t type_id = ecs_get_typeid(world, component);
+                const EcsComponent *cptr = NULL;
+                if (type_id) {
+                    cptr = ecs_get(world, type_id, EcsComponent);
+                }
+
+                /* Values for different entities are not stored contiguously, 
+                 * so terms with data are iterated one entity at a time */
+                if (cptr && cptr->size) {
+                    table_data.sparse_storage_data = true;
+                }
+            }
+
+            table_data.iter_data.components[c] = component;
+            table_data.iter_data.types[c] = get_term_type(
+                world, term, component);
+            c ++;
+            continue;
+        }
+
         /* This column does not retrieve data from a static entity */
         if (!entity && subj.entity) {
             int32_t index = get_component_index(world, table, table_type, 
@@ -689,7 +866,7 @@ add_pair:
              * the column for this specific case. Add a sparse column with the
              * case id so we can find the correct entities when iterating */
             if (ECS_HAS_ROLE(component, CASE)) {
-                ecs_sparse_column_t *sc = ecs_vector_add(
+                ecs_sparse_column_t *sc = ecs_small_vector_add(
                     &table_data.sparse_columns, ecs_sparse_column_t);
                 sc->signature_column_index = t;
                 sc->sw_case = component & ECS_COMPONENT_MASK;
@@ -705,7 +882,7 @@ add_pair:
                     (component & ECS_COMPONENT_MASK) | ECS_DISABLED;
                 int32_t bs_index = ecs_type_index_of(table->type, bs_id);
                 if (bs_index != -1) {
-                    ecs_bitset_column_t *elem = ecs_vector_add(
+                    ecs_bitset_column_t *elem = ecs_small_vector_add(
                         &table_data.bitset_columns, ecs_bitset_column_t);
                     elem->column_index = bs_index;
                     elem->bs_column = NULL;
@@ -751,10 +928,7 @@ add_pair:
 
         /* Store table index */
         matched_table_index = ecs_vector_count(query->empty_tables);
-        table_indices_count ++;
-        table_indices = ecs_os_realloc(
-            table_indices, table_indices_count * ECS_SIZEOF(int32_t));
-        table_indices[table_indices_count - 1] = -matched_table_index;
+        *ecs_small_vector_add(&table_indices, int32_t) = -matched_table_index;
 
         #ifndef NDEBUG
         char *type_expr = ecs_type_str(world, table->type);
@@ -795,14 +969,11 @@ add_pair:
 
     /* Register table indices before sending out the match signal. This signal
      * can cause table activation, and table indices are needed for that. */
-    if (table_indices) {
+    if (ecs_small_vector_count(&table_indices)) {
         ecs_table_indices_t *ti = ecs_map_ensure(
             query->table_indices, ecs_table_indices_t, table->id);
-        if (ti->indices) {
-            ecs_os_free(ti->indices);
-        }
+        ecs_small_vector_free(&ti->indices);
         ti->indices = table_indices;
-        ti->count = table_indices_count;
     }
 
     if (table && !(query->flags & EcsQueryIsSubquery)) {
@@ -885,7 +1056,7 @@ bool ecs_query_match(
     }
 
     /* Check if pair cardinality matches pairs in query, if any */
-    if (count_pairs(query, table->type) == -1) {
+    if (count_pairs(query, table) == -1) {
         return false;
     }
 
@@ -898,6 +1069,11 @@ bool ecs_query_match(
 
         failure_info->column = i + 1;
 
+        /* Ids with sparse storage are matched per entity while iterating */
+        if (term_sparse_storage(world, term)) {
+            continue;
+        }
+
         if (oper == EcsAnd) {
             if (!match_term(world, table_type, term, failure_info)) {
                 return false;
@@ -977,6 +1153,15 @@ void match_tables(
         }
     }
 
+    /* Entities that only have ids with sparse storage are stored in the root
+     * table, which is not part of the table storage */
+    ecs_table_t *root = &world->store.root;
+    if (has_sparse_and_term(world, query) && 
+        ecs_query_match(world, root, query, NULL)) 
+    {
+        add_table(world, query, root);
+    }
+
     order_grouped_tables(world, query);
 }
 
@@ -1155,17 +1340,16 @@ void build_sorted_table_range(
             helper[to_sort].shared = false;
         } else if (component) {
             /* Find component in prefab */
-            ecs_entity_t base = ecs_find_entity_in_prefabs(
-                world, 0, table->type, component, 0);
+            void *ptr = ecs_get_base_component(world, table, component);
             
             /* If a base was not found, the query should not have allowed using
              * the component for sorting */
-            ecs_assert(base != 0, ECS_INTERNAL_ERROR, NULL);
+            ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
 
             const EcsComponent *cptr = ecs_get(world, component, EcsComponent);
             ecs_assert(cptr != NULL, ECS_INTERNAL_ERROR, NULL);
 
-            helper[to_sort].ptr = ecs_get_id(world, base, component);
+            helper[to_sort].ptr = ptr;
             helper[to_sort].elem_size = cptr->size;
             helper[to_sort].shared = true;
         } else {
@@ -1544,6 +1728,8 @@ void process_signature(
 
         if (subj->entity == EcsThis) {
             query->flags |= EcsQueryNeedsTables;
+        } else if (subj->entity) {
+            query->flags |= EcsQueryHasSubjects;
         }
 
         if (subj->set.mask & EcsCascade && term->oper == EcsOptional) {
@@ -1604,9 +1790,10 @@ int32_t move_table(
         ecs_table_indices_t *ti = ecs_map_get(query->table_indices, 
             ecs_table_indices_t, mt->iter_data.table->id);
 
-        int i, count = ti->count;
+        int32_t *indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+        int i, count = ecs_small_vector_count(&ti->indices);
         for (i = 0; i < count; i ++) {
-            int32_t old_index = ti->indices[i];
+            int32_t old_index = indices[i];
             if (activate) {
                 if (old_index >= 0) {
                     /* old_index should be negative if activate is true, since
@@ -1625,9 +1812,9 @@ int32_t move_table(
             /* Ensure to update correct index, as there can be more than one */
             if (old_index == last_src_index) {
                 if (activate) {
-                    ti->indices[i] = index * -1 - 1;
+                    indices[i] = index * -1 - 1;
                 } else {
-                    ti->indices[i] = index;
+                    indices[i] = index;
                 }
                 break;
             }
@@ -1698,9 +1885,10 @@ void activate_table(
         query->table_indices, ecs_table_indices_t, table->id);
 
     if (ti) {
-        int32_t i, count = ti->count;
+        int32_t *indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+        int32_t i, count = ecs_small_vector_count(&ti->indices);
         for (i = 0; i < count; i ++) {
-            int32_t index = ti->indices[i];
+            int32_t index = indices[i];
 
             if (index < 0) {
                 if (!active) {
@@ -1722,7 +1910,7 @@ void activate_table(
             
             activated ++;
 
-            ti->indices[i] = move_table(
+            indices[i] = move_table(
                 query, table, index, &dst_array, src_array, active);
         }
 
@@ -1765,6 +1953,157 @@ void activate_table(
     query->needs_reorder = true;
 }
 
+/** Tables that become empty are not deactivated right away. Applications that
+ * delete and create entities often flip the same tables between empty and
+ * non-empty several times per frame, and each flip moves the table between the
+ * table lists of the query. Instead deactivations are applied in a single pass
+ * the next time the query is iterated or the world is merged, and cancelled
+ * when the table becomes non-empty before that. Iterators skip empty tables in
+ * the meantime. */
+static
+void update_table_index(
+    ecs_table_indices_t *ti,
+    int32_t old_index,
+    int32_t new_index)
+{
+    int32_t *indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+    int32_t i, count = ecs_small_vector_count(&ti->indices);
+    for (i = 0; i < count; i ++) {
+        if (indices[i] == old_index) {
+            indices[i] = new_index;
+            return;
+        }
+    }
+
+    ecs_abort(ECS_INTERNAL_ERROR, NULL);
+}
+
+static
+void deactivate_tables(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    ecs_matched_table_t *tables = ecs_vector_first(
+        query->tables, ecs_matched_table_t);
+    int32_t i, count = ecs_vector_count(query->tables), active = 0;
+
+    /* Move tables to the empty list while preserving the order of the tables
+     * that remain active */
+    for (i = 0; i < count; i ++) {
+        ecs_matched_table_t *mt = &tables[i];
+        ecs_table_indices_t *ti = ecs_map_get(query->table_indices, 
+            ecs_table_indices_t, mt->iter_data.table->id);
+        ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        if (ti->deactivate) {
+            ecs_assert(!ecs_table_count(mt->iter_data.table), 
+                ECS_INTERNAL_ERROR, NULL);
+
+            int32_t index = ecs_vector_count(query->empty_tables);
+            ecs_matched_table_t *elem = ecs_vector_add(
+                &query->empty_tables, ecs_matched_table_t);
+            *elem = *mt;
+            update_table_index(ti, i, index * -1 - 1);
+        } else {
+            if (active != i) {
+                tables[active] = *mt;
+                update_table_index(ti, i, active);
+            }
+            active ++;
+        }
+    }
+
+    ecs_vector_set_count(&query->tables, ecs_matched_table_t, active);
+
+    /* Reset the flags after all entries of a table have been moved, as a table
+     * can occupy multiple entries */
+    uint64_t *ids = ecs_vector_first(query->deactivated, uint64_t);
+    count = ecs_vector_count(query->deactivated);
+    for (i = 0; i < count; i ++) {
+        ecs_table_indices_t *ti = ecs_map_get(
+            query->table_indices, ecs_table_indices_t, ids[i]);
+        if (ti) {
+            ti->deactivate = false;
+            ti->queued = false;
+        }
+    }
+
+    ecs_vector_clear(query->deactivated);
+    query->deactivated_count = 0;
+    query->needs_reorder = true;
+
+#ifdef FLECS_SYSTEMS_H
+    if (query->system && !active) {
+        ecs_system_activate(world, query->system, false, NULL);
+    }
+#else
+    (void)world;
+#endif
+}
+
+static
+void deactivate_table_deferred(
+    ecs_world_t *world,
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    ecs_table_indices_t *ti = ecs_map_get(
+        query->table_indices, ecs_table_indices_t, table->id);
+
+    if (!ti) {
+        /* Received an activate event for a table we're not matched with. This
+         * can only happen if this is a subquery */
+        ecs_assert((query->flags & EcsQueryIsSubquery) != 0, 
+            ECS_INTERNAL_ERROR, NULL);
+        return;
+    }
+
+    if (ti->deactivate) {
+        return;
+    }
+
+    ti->deactivate = true;
+    query->deactivated_count += ecs_small_vector_count(&ti->indices);
+
+    /* A cancelled deactivation leaves the table in the list, so a table that
+     * flips between empty and non-empty is only added once */
+    if (!ti->queued) {
+        uint64_t *elem = ecs_vector_add(&query->deactivated, uint64_t);
+        *elem = table->id;
+        ti->queued = true;
+    }
+
+    /* If this leaves a system without active tables, deactivate right away so
+     * that the system status is updated immediately */
+    if (query->system && 
+        query->deactivated_count >= ecs_vector_count(query->tables)) 
+    {
+        deactivate_tables(world, query);
+    } else {
+        world->tables_deactivated = true;
+    }
+}
+
+static
+void activate_table_deferred(
+    ecs_world_t *world,
+    ecs_query_t *query,
+    ecs_table_t *table)
+{
+    ecs_table_indices_t *ti = ecs_map_get(
+        query->table_indices, ecs_table_indices_t, table->id);
+
+    /* If the table still has to be deactivated it is still in the list with
+     * active tables, so all that's needed is to cancel the deactivation. */
+    if (ti && ti->deactivate) {
+        ti->deactivate = false;
+        query->deactivated_count -= ecs_small_vector_count(&ti->indices);
+        return;
+    }
+
+    activate_table(world, query, table, true);
+}
+
 static
 void add_subquery(
     ecs_world_t *world, 
@@ -1822,8 +2161,9 @@ void free_matched_table(
     ecs_os_free(table->iter_data.components);
     ecs_os_free((ecs_vector_t**)table->iter_data.types);
     ecs_os_free(table->iter_data.references);
-    ecs_os_free(table->sparse_columns);
-    ecs_os_free(table->bitset_columns);
+    ecs_small_vector_free(&table->sparse_columns);
+    ecs_small_vector_free(&table->bitset_columns);
+    ecs_vector_free(table->sparse_storage);
     ecs_os_free(table->monitor);
 }
 
@@ -1847,9 +2187,10 @@ void resolve_cascade_subject(
     ecs_term_t *term = &query->filter.terms[term_index];
 
     /* For each table entry, find the correct subject of a cascade term */
-    int32_t i, count = ti->count;
+    int32_t *indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+    int32_t i, count = ecs_small_vector_count(&ti->indices);
     for (i = 0; i < count; i ++) {
-        int32_t table_data_index = ti->indices[i];
+        int32_t table_data_index = indices[i];
         ecs_matched_table_t *table_data;
 
         if (table_data_index >= 0) {
@@ -1929,9 +2270,17 @@ void unmatch_table(
         }
     }
 
-    int32_t i, count = ti->count;
+    int32_t *indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+    int32_t i, count = ecs_small_vector_count(&ti->indices);
+
+    /* Entries of a table with a pending deactivation are removed here, so
+     * they should no longer be counted as pending */
+    if (ti->deactivate) {
+        query->deactivated_count -= count;
+    }
+
     for (i = 0; i < count; i ++) {
-        int32_t index = ti->indices[i];
+        int32_t index = indices[i];
         if (index < 0) {
             index = index * -1 - 1;
             remove_table(query, table, query->empty_tables, index, true);
@@ -1940,7 +2289,7 @@ void unmatch_table(
         }
     }
 
-    ecs_os_free(ti->indices);
+    ecs_small_vector_free(&ti->indices);
     ecs_map_remove(query->table_indices, table->id);
 }
 
@@ -2029,9 +2378,25 @@ static
 void rematch_tables(
     ecs_world_t *world,
     ecs_query_t *query,
-    ecs_query_t *parent_query)
+    ecs_query_t *parent_query,
+    ecs_vector_t *rematch)
 {
-    if (parent_query) {
+    /* Terms with a fixed subject can change whether any table matches, in
+     * which case all tables have to be rematched */
+    if (rematch && !(query->flags & EcsQueryHasSubjects)) {
+        ecs_table_t **tables = ecs_vector_first(rematch, ecs_table_t*);
+        int32_t i, count = ecs_vector_count(rematch);
+        for (i = 0; i < count; i ++) {
+            ecs_table_t *table = tables[i];
+
+            /* Subqueries can only match tables of the parent query */
+            if (parent_query && !get_table_indices(parent_query, table)) {
+                continue;
+            }
+
+            rematch_table(world, query, table);
+        }
+    } else if (parent_query) {
         ecs_matched_table_t *tables = ecs_vector_first(parent_query->tables, ecs_matched_table_t);
         int32_t i, count = ecs_vector_count(parent_query->tables);
         for (i = 0; i < count; i ++) {
@@ -2110,15 +2475,15 @@ void ecs_query_notify(
         break;
     case EcsQueryTableRematch:
         /* Rematch tables of query */
-        rematch_tables(world, query, event->parent_query);
+        rematch_tables(world, query, event->parent_query, event->tables);
         break;        
     case EcsQueryTableEmpty:
         /* Table is empty, deactivate */
-        activate_table(world, query, event->table, false);
+        deactivate_table_deferred(world, query, event->table);
         break;
     case EcsQueryTableNonEmpty:
         /* Table is non-empty, activate */
-        activate_table(world, query, event->table, true);
+        activate_table_deferred(world, query, event->table);
         break;
     case EcsQueryOrphan:
         ecs_assert(query->flags & EcsQueryIsSubquery, ECS_INTERNAL_ERROR, NULL);
@@ -2132,6 +2497,31 @@ void ecs_query_notify(
     }
 }
 
+void ecs_query_deactivate_tables(
+    ecs_world_t *world,
+    ecs_query_t *query)
+{
+    if (ecs_vector_count(query->deactivated)) {
+        deactivate_tables(world, query);
+    }
+}
+
+void ecs_world_deactivate_tables(
+    ecs_world_t *world)
+{
+    if (!world->tables_deactivated) {
+        return;
+    }
+
+    world->tables_deactivated = false;
+
+    int32_t i;
+    for (i = 0; i < ecs_sparse_count(world->queries); i ++) {
+        ecs_query_t *query = ecs_sparse_get(world->queries, ecs_query_t, i);
+        ecs_query_deactivate_tables(world, query);
+    }
+}
+
 
 /* -- Public API -- */
 
@@ -2232,6 +2622,10 @@ ecs_query_t* ecs_query_init(
         result->group_by_ctx_free = desc->group_by_ctx_free;
     }
 
+    if (can_iter_sparse(world, result)) {
+        result->flags |= EcsQueryIterSparse;
+    }
+
     ecs_log_pop();
 
     return result;
@@ -2283,13 +2677,14 @@ void ecs_query_fini(
     ecs_map_iter_t it = ecs_map_iter(query->table_indices);
     ecs_table_indices_t *ti;
     while ((ti = ecs_map_next(&it, ecs_table_indices_t, NULL))) {
-        ecs_os_free(ti->indices);
+        ecs_small_vector_free(&ti->indices);
     }
 
     ecs_map_free(query->table_indices);
     ecs_vector_free(query->subqueries);
     ecs_vector_free(query->tables);
     ecs_vector_free(query->empty_tables);
+    ecs_vector_free(query->deactivated);
     ecs_vector_free(query->table_slices);
     ecs_filter_fini(&query->filter);
     
@@ -2314,6 +2709,10 @@ ecs_iter_t ecs_query_iter_page(
 
     ecs_world_t *world = query->world;
 
+    if (!world->is_readonly) {
+        ecs_query_deactivate_tables(world, query);
+    }
+
     if (query->needs_reorder) {
         order_grouped_tables(world, query);
     }
@@ -2342,6 +2741,10 @@ ecs_iter_t ecs_query_iter_page(
         .index = 0,
     };
 
+    if (query->flags & EcsQueryIterSparse) {
+        it.storage_id = smallest_sparse_term(world, query);
+    }
+
     return (ecs_iter_t){
         .world = world,
         .query = query,
@@ -2439,11 +2842,11 @@ static
 int find_smallest_column(
     ecs_table_t *table,
     ecs_matched_table_t *table_data,
-    ecs_vector_t *sparse_columns)
+    ecs_small_vector_t *sparse_columns)
 {
     ecs_sparse_column_t *sparse_column_array = 
-        ecs_vector_first(sparse_columns, ecs_sparse_column_t);
-    int32_t i, count = ecs_vector_count(sparse_columns);
+        ecs_small_vector_first_t(sparse_columns, ecs_sparse_column_t);
+    int32_t i, count = ecs_small_vector_count(sparse_columns);
     int32_t min = INT_MAX, index = 0;
 
     for (i = 0; i < count; i ++) {
@@ -2485,7 +2888,7 @@ static
 int sparse_column_next(
     ecs_table_t *table,
     ecs_matched_table_t *matched_table,
-    ecs_vector_t *sparse_columns,
+    ecs_small_vector_t *sparse_columns,
     ecs_query_iter_t *iter,
     ecs_page_cursor_t *cur)
 {
@@ -2500,7 +2903,7 @@ int sparse_column_next(
 
     sparse_smallest -= 1;
 
-    ecs_sparse_column_t *columns = ecs_vector_first(
+    ecs_sparse_column_t *columns = ecs_small_vector_first_t(
         sparse_columns, ecs_sparse_column_t);
     ecs_sparse_column_t *column = &columns[sparse_smallest];
     ecs_switch_t *sw, *sw_smallest = column->sw_column->data;
@@ -2519,7 +2922,7 @@ int sparse_column_next(
     }    
 
     /* Check if entity matches with other sparse columns, if any */
-    int32_t i, count = ecs_vector_count(sparse_columns);
+    int32_t i, count = ecs_small_vector_count(sparse_columns);
     do {
         for (i = 0; i < count; i ++) {
             if (i == sparse_smallest) {
@@ -2552,12 +2955,114 @@ done:
     return -1;
 }
 
+/* Get the storages for the sparse terms of a matched table. Terms store the id
+ * instead of the storage, as the storage is deleted with the id. */
+static
+void sparse_storage_get_terms(
+    const ecs_world_t *world,
+    ecs_sparse_storage_term_t *terms,
+    int32_t count,
+    ecs_sparse_t **storages)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        storages[i] = ecs_sparse_storage_get(world, terms[i].id);
+    }
+}
+
+static
+bool sparse_storage_match(
+    ecs_sparse_storage_term_t *terms,
+    ecs_sparse_t **storages,
+    int32_t count,
+    ecs_entity_t entity)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        ecs_oper_kind_t oper = terms[i].oper;
+        if (oper == EcsOptional) {
+            continue;
+        }
+
+        ecs_sparse_t *storage = storages[i];
+        bool has = storage && ecs_sparse_storage_get_ptr(storage, entity);
+        if (has == (oper == EcsNot)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+int sparse_storage_next(
+    const ecs_world_t *world,
+    ecs_matched_table_t *matched_table,
+    ecs_data_t *data,
+    ecs_query_iter_t *iter,
+    ecs_page_cursor_t *cur)
+{
+    ecs_vector_t *sparse_storage = matched_table->sparse_storage;
+    ecs_sparse_storage_term_t *terms = ecs_vector_first(
+        sparse_storage, ecs_sparse_storage_term_t);
+    int32_t term_count = ecs_vector_count(sparse_storage);
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    int32_t row, end;
+
+    ecs_sparse_t **storages = ecs_os_alloca(
+        ECS_SIZEOF(ecs_sparse_t*) * term_count);
+    sparse_storage_get_terms(world, terms, term_count, storages);
+
+    /* If a range was partially iterated, continue where we left off */
+    if (iter->sparse_storage_last) {
+        row = iter->sparse_storage_first;
+        end = iter->sparse_storage_last;
+    } else {
+        row = cur->first;
+        end = cur->first + cur->count;
+    }
+
+    /* Find first entity that matches */
+    for (; row < end; row ++) {
+        if (sparse_storage_match(terms, storages, term_count, entities[row])) {
+            break;
+        }
+    }
+
+    if (row == end) {
+        iter->sparse_storage_first = 0;
+        iter->sparse_storage_last = 0;
+        return -1;
+    }
+
+    int32_t first = row ++;
+
+    /* If no data needs to be accessed, return the largest matching range */
+    if (!matched_table->sparse_storage_data) {
+        for (; row < end; row ++) {
+            if (!sparse_storage_match(
+                terms, storages, term_count, entities[row])) 
+            {
+                break;
+            }
+        }
+    }
+
+    cur->first = first;
+    cur->count = row - first;
+
+    iter->sparse_storage_first = row;
+    iter->sparse_storage_last = end;
+
+    return 0;
+}
+
 #define BS_MAX ((uint64_t)0xFFFFFFFFFFFFFFFF)
 
 static
 int bitset_column_next(
     ecs_table_t *table,
-    ecs_vector_t *bitset_columns,
+    ecs_small_vector_t *bitset_columns,
     ecs_query_iter_t *iter,
     ecs_page_cursor_t *cur)
 {
@@ -2607,8 +3112,8 @@ int bitset_column_next(
     BS_MAX - (BS_MAX >> 1)
     };
 
-    int32_t i, count = ecs_vector_count(bitset_columns);
-    ecs_bitset_column_t *columns = ecs_vector_first(
+    int32_t i, count = ecs_small_vector_count(bitset_columns);
+    ecs_bitset_column_t *columns = ecs_small_vector_first_t(
         bitset_columns, ecs_bitset_column_t);
     int32_t bs_offset = table->bs_column_offset;
 
@@ -2770,6 +3275,104 @@ void mark_columns_dirty(
     }
 }
 
+/* Iterate the entities of the smallest sparse storage of the query, and return
+ * the ones that are in a matched table one by one. */
+static
+bool sparse_storage_iter_next(
+    ecs_iter_t *it)
+{
+    ecs_query_iter_t *iter = &it->iter.query;
+    ecs_query_t *query = it->query;
+    ecs_world_t *world = query->world;
+    int32_t prev_count = it->total_count;
+
+    ecs_sparse_t *storage = ecs_sparse_storage_get(world, iter->storage_id);
+    if (!storage) {
+        return false;
+    }
+
+    const uint64_t *indices = ecs_sparse_ids(storage);
+    int32_t count = ecs_sparse_count(storage);
+    ecs_matched_table_t *tables = ecs_vector_first(
+        query->tables, ecs_matched_table_t);
+
+    /* All matched tables have the same sparse terms */
+    ecs_sparse_t **storages = ecs_os_alloca(
+        ECS_SIZEOF(ecs_sparse_t*) * query->filter.term_count);
+    bool storages_valid = false;
+
+    for (; iter->index < count; iter->index ++, iter->storage_match = 0) {
+        /* Entities are only not stored in a table while they are deleted */
+        ecs_record_t *r = ecs_eis_get_any(world, indices[iter->index]);
+        ecs_table_t *table;
+        if (!r || !(table = r->table)) {
+            continue;
+        }
+
+        ecs_table_indices_t *ti = ecs_map_get(
+            query->table_indices, ecs_table_indices_t, table->id);
+        if (!ti) {
+            continue;
+        }
+
+        bool is_watched;
+        int32_t row = ecs_record_to_row(r->row, &is_watched);
+        ecs_data_t *data = ecs_table_get_data(table);
+        ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+
+        int32_t *table_indices = ecs_small_vector_first_t(&ti->indices, int32_t);
+        int32_t table_count = ecs_small_vector_count(&ti->indices);
+
+        while (iter->storage_match < table_count) {
+            int32_t index = table_indices[iter->storage_match ++];
+
+            /* A table with entities is never in the empty list */
+            ecs_assert(index >= 0, ECS_INTERNAL_ERROR, NULL);
+            ecs_matched_table_t *table_data = &tables[index];
+
+            ecs_vector_t *sparse_storage = table_data->sparse_storage;
+            ecs_sparse_storage_term_t *terms = ecs_vector_first(
+                sparse_storage, ecs_sparse_storage_term_t);
+            int32_t term_count = ecs_vector_count(sparse_storage);
+            if (!storages_valid) {
+                sparse_storage_get_terms(world, terms, term_count, storages);
+                storages_valid = true;
+            }
+
+            if (!sparse_storage_match(
+                terms, storages, term_count, entities[row])) 
+            {
+                continue;
+            }
+
+            ecs_page_cursor_t cur = { .first = row, .count = 1 };
+            int ret = ecs_page_iter_next(&iter->page_iter, &cur);
+            if (ret < 0) {
+                return false;
+            } else if (ret > 0) {
+                continue;
+            }
+
+            it->table_columns = data->columns;
+            it->entities = &entities[row];
+            it->offset = row;
+            it->count = 1;
+            it->total_count = 1;
+            it->table = &table_data->iter_data;
+            it->frame_offset += prev_count;
+
+            if (query->flags & EcsQueryHasOutColumns) {
+                mark_columns_dirty(query, table_data);
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /* Return next table */
 bool ecs_query_next(
     ecs_iter_t *it)
@@ -2787,6 +3390,10 @@ bool ecs_query_next(
         return false;
     }
 
+    if (query->flags & EcsQueryIterSparse) {
+        return sparse_storage_iter_next(it);
+    }
+
     ecs_table_slice_t *slice = ecs_vector_first(
         query->table_slices, ecs_table_slice_t);
     ecs_matched_table_t *tables = ecs_vector_first(
@@ -2807,8 +3414,14 @@ bool ecs_query_next(
         iter->index = i + 1;
         
         if (table) {
-            ecs_vector_t *bitset_columns = table_data->bitset_columns;
-            ecs_vector_t *sparse_columns = table_data->sparse_columns;
+            ecs_small_vector_t *bitset_columns = NULL;
+            ecs_small_vector_t *sparse_columns = NULL;
+            if (ecs_small_vector_count(&table_data->bitset_columns)) {
+                bitset_columns = &table_data->bitset_columns;
+            }
+            if (ecs_small_vector_count(&table_data->sparse_columns)) {
+                sparse_columns = &table_data->sparse_columns;
+            }
             data = ecs_table_get_data(table);
             ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
             it->table_columns = data->columns;
@@ -2822,7 +3435,11 @@ bool ecs_query_next(
             }
 
             if (cur.count) {
-                if (bitset_columns) {
+                /* Don't advance bitset/sparse columns while the range they
+                 * returned is still being filtered by sparse storage */
+                bool storage_pending = iter->sparse_storage_last != 0;
+
+                if (bitset_columns && !storage_pending) {
             
                     if (bitset_column_next(table, bitset_columns, iter, 
                         &cur) == -1) 
@@ -2834,7 +3451,7 @@ bool ecs_query_next(
                     }
                 }
 
-                if (sparse_columns) {
+                if (sparse_columns && !storage_pending) {
                     if (sparse_column_next(table, table_data,
                         sparse_columns, iter, &cur) == -1)
                     {
@@ -2845,6 +3462,22 @@ bool ecs_query_next(
                     }
                 }
 
+                if (table_data->sparse_storage) {
+                    if (sparse_storage_next(
+                        world, table_data, data, iter, &cur) == -1)
+                    {
+                        /* If the range was provided by a bitset or sparse 
+                         * column, get the next range for the same table */
+                        if (bitset_columns || sparse_columns) {
+                            iter->index = i;
+                            i --;
+                        }
+                        continue;
+                    } else {
+                        iter->index = i;
+                    }
+                }
+
                 int ret = ecs_page_iter_next(piter, &cur);
                 if (ret < 0) {
                     return false;
@@ -2894,28 +3527,83 @@ bool ecs_query_next_w_filter(
     return true;
 }
 
+/* Get the rank of a table returned by the iterator. The iterator table is the
+ * first member of the matched table, so the matched table can be obtained by
+ * casting it. */
+static
+int32_t iter_table_rank(
+    const ecs_iter_table_t *table)
+{
+    return ((const ecs_matched_table_t*)table)->rank;
+}
+
+/* Wait until all workers have finished iterating the current cascade level */
+static
+void cascade_level_barrier(
+    ecs_world_t *world,
+    int32_t total)
+{
+    ecs_os_mutex_lock(world->sync_mutex);
+
+    int32_t generation = world->level_generation;
+    if (++ world->level_waiting == total) {
+        world->level_waiting = 0;
+        world->level_generation ++;
+        ecs_os_cond_broadcast(world->level_cond);
+    } else {
+        while (generation == world->level_generation) {
+            ecs_os_cond_wait(world->level_cond, world->sync_mutex);
+        }
+    }
+
+    ecs_os_mutex_unlock(world->sync_mutex);
+}
+
 bool ecs_query_next_worker(
     ecs_iter_t *it,
     int32_t current,
     int32_t total)
 {
     int32_t per_worker, first, prev_offset = it->offset;
+    ecs_world_t *world = it->world;
+    ecs_stage_t *stage = ecs_stage_from_world(&world);
+
+    /* When a CASCADE query is iterated by worker threads, all workers must be
+     * done with a depth level before any worker can start on the next one, as
+     * tables in the next level may depend on data written for the previous
+     * level. Tables within a level are iterated in parallel. */
+    bool level_sync = it->query->cascade_by && stage->thread;
 
     do {
+        const ecs_iter_table_t *prev_table = it->table;
+
         if (!ecs_query_next(it)) {
             return false;
         }
 
+        if (level_sync && prev_table && 
+            iter_table_rank(prev_table) != iter_table_rank(it->table)) 
+        {
+            cascade_level_barrier(world, total);
+        }
+
+        /* For levels with many small tables, assign the remaining entities of
+         * each table to a different worker so they are spread out evenly */
+        int32_t worker = current;
+        if (level_sync) {
+            worker = (current + it->iter.query.index) % total;
+        }
+
         int32_t count = it->count;
         per_worker = count / total;
-        first = per_worker * current;
+        first = per_worker * worker;
 
         count -= per_worker * total;
 
         if (count) {
-            if (current < count) {
+            if (worker < count) {
                 per_worker ++;
-                first += current;
+                first += worker;
             } else {
                 first += count;
             }
@@ -2951,6 +3639,7 @@ void ecs_query_order_by(
 
     query->order_by_component = order_by_component;
     query->order_by = order_by;
+    query->flags &= ~EcsQueryIterSparse;
 
     ecs_vector_free(query->table_slices);
     query->table_slices = NULL;
@@ -2974,6 +3663,7 @@ void ecs_query_group_by(
 
     query->group_by_id = sort_component;
     query->group_by = group_by;
+    query->flags &= ~EcsQueryIterSparse;
 
     group_tables(world, query);
 
@@ -12,6 +12,10 @@
 /* Utility to get a pointer to the payload */
 #define DATA(array, size, offset) (ECS_OFFSET(array, size * offset))
 
+/* Utility to get a pointer to the payload in the reserved data array */
+#define VM_DATA(sparse, index)\
+    (ECS_OFFSET((sparse)->vm_data, (uint64_t)(sparse)->size * (index)))
+
 typedef struct chunk_t {
     int32_t *sparse;            /* Sparse array with indices to dense array */
     void *data;                 /* Store data in sparse array to reduce  
@@ -29,6 +33,15 @@ struct ecs_sparse_t {
     int32_t count;              /* Number of alive entries */
     uint64_t max_id_local;      /* Local max index (if no global is set) */
     uint64_t *max_id;           /* Maximum issued sparse index */
+
+    /* Reserved virtual memory (optional). Chunks for indices in the reserved
+     * range point into the reserved arrays, and lookups for those indices
+     * directly index the arrays without going through the chunk. */
+    void *vm;                   /* Start of reserved range */
+    size_t vm_size;             /* Size of reserved range */
+    int32_t *vm_sparse;         /* Reserved sparse array */
+    void *vm_data;              /* Reserved data array */
+    uint64_t vm_count;          /* Number of indices in reserved arrays */
 };
 
 static
@@ -53,6 +66,16 @@ chunk_t* chunk_new(
     ecs_assert(result->sparse == NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(result->data == NULL, ECS_INTERNAL_ERROR, NULL);
 
+    /* If chunk is in the reserved range, use the reserved memory. The OS
+     * zero-initializes the memory, so the chunk doesn't need to be allocated
+     * or initialized. */
+    uint64_t offset = (uint64_t)chunk_index * CHUNK_COUNT;
+    if (offset < sparse->vm_count) {
+        result->sparse = &sparse->vm_sparse[offset];
+        result->data = VM_DATA(sparse, offset);
+        return result;
+    }
+
     /* Initialize sparse array with zero's, as zero is used to indicate that the
      * sparse element has not been paired with a dense element. Use zero
      * as this means we can take advantage of calloc having a possibly better 
@@ -72,8 +95,15 @@ chunk_t* chunk_new(
 
 static
 void chunk_free(
+    ecs_sparse_t *sparse,
+    int32_t chunk_index,
     chunk_t *chunk)
 {
+    /* Chunks in the reserved range are not individually allocated */
+    if ((uint64_t)chunk_index * CHUNK_COUNT < sparse->vm_count) {
+        return;
+    }
+
     ecs_os_free(chunk->sparse);
     ecs_os_free(chunk->data);
 }
@@ -223,20 +253,29 @@ void* try_sparse_any(
 {    
     strip_generation(&index);
 
-    chunk_t *chunk = get_chunk(sparse, CHUNK(index));
-    if (!chunk) {
-        return NULL;
+    int32_t dense;
+    void *data;
+
+    if (index < sparse->vm_count) {
+        dense = sparse->vm_sparse[index];
+        data = VM_DATA(sparse, index);
+    } else {
+        chunk_t *chunk = get_chunk(sparse, CHUNK(index));
+        if (!chunk) {
+            return NULL;
+        }
+
+        int32_t offset = OFFSET(index);
+        dense = chunk->sparse[offset];
+        data = DATA(chunk->data, sparse->size, offset);
     }
 
-    int32_t offset = OFFSET(index);
-    int32_t dense = chunk->sparse[offset];
     bool in_use = dense && (dense < sparse->count);
     if (!in_use) {
         return NULL;
     }
 
-    ecs_assert(dense == chunk->sparse[offset], ECS_INTERNAL_ERROR, NULL);
-    return DATA(chunk->data, sparse->size, offset);
+    return data;
 }
 
 /* Try obtaining a value from the sparse set, make sure it's alive. */
@@ -245,19 +284,29 @@ void* try_sparse(
     const ecs_sparse_t *sparse,
     uint64_t index)
 {
-    chunk_t *chunk = get_chunk(sparse, CHUNK(index));
-    if (!chunk) {
-        return NULL;
+    uint64_t gen = strip_generation(&index);
+    int32_t dense;
+    void *data;
+
+    if (index < sparse->vm_count) {
+        dense = sparse->vm_sparse[index];
+        data = VM_DATA(sparse, index);
+    } else {
+        chunk_t *chunk = get_chunk(sparse, CHUNK(index));
+        if (!chunk) {
+            return NULL;
+        }
+
+        int32_t offset = OFFSET(index);
+        dense = chunk->sparse[offset];
+        data = DATA(chunk->data, sparse->size, offset);
     }
 
-    int32_t offset = OFFSET(index);
-    int32_t dense = chunk->sparse[offset];
     bool in_use = dense && (dense < sparse->count);
     if (!in_use) {
         return NULL;
     }
 
-    uint64_t gen = strip_generation(&index);
     uint64_t *dense_array = ecs_vector_first(sparse->dense, uint64_t);
     uint64_t cur_gen = dense_array[dense] & ECS_GENERATION_MASK;
 
@@ -265,8 +314,7 @@ void* try_sparse(
         return NULL;
     }
 
-    ecs_assert(dense == chunk->sparse[offset], ECS_INTERNAL_ERROR, NULL);
-    return DATA(chunk->data, sparse->size, offset);
+    return data;
 }
 
 /* Get value from sparse set when it is guaranteed that the value exists. This
@@ -339,9 +387,18 @@ void ecs_sparse_clear(
 {
     ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
 
-    ecs_vector_each(sparse->chunks, chunk_t, chunk, {
-        chunk_free(chunk);
-    });
+    int32_t i, count = ecs_vector_count(sparse->chunks);
+    chunk_t *chunks = ecs_vector_first(sparse->chunks, chunk_t);
+    for (i = 0; i < count; i ++) {
+        if (chunks[i].sparse) {
+            chunk_free(sparse, i, &chunks[i]);
+        }
+    }
+
+    /* Discard contents of reserved range, so that it reads as zero again */
+    if (sparse->vm && count) {
+        ecs_os_vm_reset(sparse->vm, sparse->vm_size);
+    }
 
     ecs_vector_free(sparse->chunks);
     ecs_vector_set_count(&sparse->dense, uint64_t, 1);
@@ -351,16 +408,146 @@ void ecs_sparse_clear(
     sparse->max_id_local = 0;
 }
 
+int64_t ecs_sparse_compact(
+    ecs_sparse_t *sparse)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    int64_t freed = 0;
+    ecs_size_t size = sparse->size;
+    int32_t i, count = sparse->count;
+    int32_t dense_count = ecs_vector_count(sparse->dense);
+    uint64_t *dense_array = ecs_vector_first(sparse->dense, uint64_t);
+
+    /* Chunks after the chunk of the largest alive index only contain removed
+     * elements, and can be freed. Chunks before it are kept, so that removed
+     * elements in those chunks can still be recycled. */
+    int32_t keep = 0;
+    for (i = 1; i < count; i ++) {
+        uint64_t index = dense_array[i];
+        strip_generation(&index);
+        if (CHUNK(index) >= keep) {
+            keep = CHUNK(index) + 1;
+        }
+    }
+
+    /* Remove elements in freed chunks from the list of removed elements.
+     * Their generation is lost with the chunk, so they are not recycled. */
+    int32_t dead = count;
+    for (i = count; i < dense_count; i ++) {
+        uint64_t id = dense_array[i];
+        uint64_t index = id;
+        strip_generation(&index);
+
+        if (CHUNK(index) >= keep) {
+            continue;
+        }
+
+        if (dead != i) {
+            chunk_t *chunk = get_chunk(sparse, CHUNK(index));
+            ecs_assert(chunk != NULL, ECS_INTERNAL_ERROR, NULL);
+            chunk->sparse[OFFSET(index)] = dead;
+            dense_array[dead] = id;
+        }
+
+        dead ++;
+    }
+
+    int32_t dense_size = ecs_vector_size(sparse->dense);
+    ecs_vector_set_count(&sparse->dense, uint64_t, dead);
+    ecs_vector_reclaim(&sparse->dense, uint64_t);
+    freed += (dense_size - ecs_vector_size(sparse->dense)) *
+        ECS_SIZEOF(uint64_t);
+
+    int32_t chunk_count = ecs_vector_count(sparse->chunks);
+    chunk_t *chunks = ecs_vector_first(sparse->chunks, chunk_t);
+
+    for (i = keep; i < chunk_count; i ++) {
+        chunk_t *chunk = &chunks[i];
+        if (!chunk->sparse) {
+            continue;
+        }
+
+        /* Chunks in the reserved range are returned to the OS. Chunk offsets
+         * are multiples of CHUNK_COUNT, so both ranges are page aligned. */
+        if ((uint64_t)i * CHUNK_COUNT < sparse->vm_count) {
+            ecs_os_vm_reset(chunk->sparse,
+                sizeof(int32_t) * CHUNK_COUNT);
+            ecs_os_vm_reset(chunk->data,
+                (size_t)size * CHUNK_COUNT);
+        } else {
+            chunk_free(sparse, i, chunk);
+        }
+
+        chunk->sparse = NULL;
+        chunk->data = NULL;
+        freed += (ECS_SIZEOF(int32_t) + size) * CHUNK_COUNT;
+    }
+
+    if (sparse->chunks && keep < chunk_count) {
+        int32_t chunks_size = ecs_vector_size(sparse->chunks);
+        ecs_vector_set_count(&sparse->chunks, chunk_t, keep);
+        ecs_vector_reclaim(&sparse->chunks, chunk_t);
+        freed += (chunks_size - ecs_vector_size(sparse->chunks)) *
+            ECS_SIZEOF(chunk_t);
+    }
+
+    return freed;
+}
+
 void ecs_sparse_free(
     ecs_sparse_t *sparse)
 {
     if (sparse) {
         ecs_sparse_clear(sparse);
         ecs_vector_free(sparse->dense);
+        if (sparse->vm) {
+            ecs_os_vm_release(sparse->vm, sparse->vm_size);
+        }
         ecs_os_free(sparse);
     }
 }
 
+bool ecs_sparse_reserve_vm(
+    ecs_sparse_t *sparse,
+    uint64_t count,
+    bool huge_pages)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(sparse->vm == NULL, ECS_INVALID_OPERATION, NULL);
+    ecs_assert(ecs_vector_count(sparse->chunks) == 0, 
+        ECS_INVALID_OPERATION, NULL);
+
+    if (!ecs_os_has_vm() || !count) {
+        return false;
+    }
+
+    /* Round up to whole chunks, which also page-aligns the data array */
+    count = ((count - 1) / CHUNK_COUNT + 1) * CHUNK_COUNT;
+
+    /* The range doesn't fit in the address space (32 bit platforms) */
+    uint64_t index_size = sizeof(int32_t) + (uint64_t)sparse->size;
+    if (count > SIZE_MAX / index_size) {
+        return false;
+    }
+
+    size_t sparse_size = sizeof(int32_t) * (size_t)count;
+    size_t size = sparse_size + (size_t)sparse->size * (size_t)count;
+
+    void *vm = ecs_os_vm_reserve(size, huge_pages);
+    if (!vm) {
+        return false;
+    }
+
+    sparse->vm = vm;
+    sparse->vm_size = size;
+    sparse->vm_sparse = vm;
+    sparse->vm_data = ECS_OFFSET(vm, sparse_size);
+    sparse->vm_count = count;
+
+    return true;
+}
+
 uint64_t ecs_sparse_new_id(
     ecs_sparse_t *sparse)
 {
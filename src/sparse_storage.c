@@ -0,0 +1,262 @@
+#include "private_api.h"
+
+/* Components with the EcsSparse tag are not stored in tables. Instead, each id
+ * has a sparse set that maps entity ids to component values. The sparse set is
+ * indexed with the entity id stripped from its generation, as the entity index
+ * already guarantees liveliness. Entities are removed from the storage when
+ * they are deleted, which ensures that a recycled id never sees stale data. */
+
+static
+ecs_size_t storage_elem_size(
+    const ecs_world_t *world,
+    ecs_id_t id)
+{
+    ecs_entity_t real_id = ecs_get_typeid(world, id);
+    if (!real_id) {
+        return 0;
+    }
+
+    const EcsComponent *ptr = ecs_get(world, real_id, EcsComponent);
+    if (!ptr) {
+        return 0;
+    }
+
+    return ptr->size;
+}
+
+static
+const ecs_type_info_t* storage_type_info(
+    const ecs_world_t *world,
+    ecs_id_t id)
+{
+    ecs_entity_t real_id = ecs_get_typeid(world, id);
+    if (real_id) {
+        return ecs_get_c_info(world, real_id);
+    } else {
+        return NULL;
+    }
+}
+
+static
+void storage_dtor(
+    ecs_world_t *world,
+    const ecs_type_info_t *c_info,
+    ecs_entity_t entity,
+    void *ptr,
+    ecs_size_t size)
+{
+    ecs_xtor_t dtor;
+    if (c_info && (dtor = c_info->lifecycle.dtor)) {
+        dtor(world, c_info->component, &entity, ptr, ecs_to_size_t(size), 1,
+            c_info->lifecycle.ctx);
+    }
+}
+
+static
+void storage_free(
+    ecs_world_t *world,
+    ecs_id_t id,
+    ecs_sparse_t *storage)
+{
+    ecs_size_t size = storage_elem_size(world, id);
+    const ecs_type_info_t *c_info = storage_type_info(world, id);
+
+    if (size && c_info && c_info->lifecycle.dtor) {
+        const uint64_t *entities = ecs_sparse_ids(storage);
+        int32_t i, count = ecs_sparse_count(storage);
+        for (i = 0; i < count; i ++) {
+            void *ptr = _ecs_sparse_get(storage, 0, i);
+            storage_dtor(world, c_info, entities[i], ptr, size);
+        }
+    }
+
+    ecs_sparse_free(storage);
+}
+
+void ecs_sparse_storage_init(
+    ecs_world_t *world,
+    ecs_id_t id)
+{
+    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(id != 0, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_id_record_t *idr = ecs_ensure_id_record(world, id);
+    ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (idr->sparse) {
+        return;
+    }
+
+    /* The storage of an id can't be changed while it is stored in tables */
+    ecs_assert(!ecs_map_count(idr->table_index), ECS_INVALID_OPERATION, NULL);
+
+    /* Tags still need an element in the sparse set. Use the smallest possible
+     * element size so that the storage can also be used to test for presence */
+    ecs_size_t size = storage_elem_size(world, id);
+    if (!size) {
+        size = ECS_SIZEOF(bool);
+    }
+
+    idr->sparse = _ecs_sparse_new(size);
+
+    ecs_id_t *elem = ecs_vector_add(&world->store.sparse_ids, ecs_id_t);
+    *elem = id;
+
+    /* Make sure that storage is cleaned up when the id is deleted */
+    ecs_set_watch(world, id);
+}
+
+void ecs_sparse_storage_fini(
+    ecs_world_t *world,
+    ecs_id_t id,
+    ecs_id_record_t *idr)
+{
+    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_sparse_t *storage = idr->sparse;
+    if (!storage) {
+        return;
+    }
+
+    idr->sparse = NULL;
+    storage_free(world, id, storage);
+
+    ecs_id_t *ids = ecs_vector_first(world->store.sparse_ids, ecs_id_t);
+    int32_t i, count = ecs_vector_count(world->store.sparse_ids);
+    for (i = 0; i < count; i ++) {
+        if (ids[i] == id) {
+            ecs_vector_remove(world->store.sparse_ids, ecs_id_t, i);
+            break;
+        }
+    }
+
+    if (!ecs_vector_count(world->store.sparse_ids)) {
+        ecs_vector_free(world->store.sparse_ids);
+        world->store.sparse_ids = NULL;
+    }
+}
+
+void ecs_sparse_storage_fini_all(
+    ecs_world_t *world)
+{
+    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    while (ecs_vector_count(world->store.sparse_ids)) {
+        ecs_id_t id = ecs_vector_first(world->store.sparse_ids, ecs_id_t)[0];
+        ecs_id_record_t *idr = ecs_get_id_record(world, id);
+        ecs_assert(idr != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_sparse_storage_fini(world, id, idr);
+    }
+}
+
+ecs_sparse_t* ecs_sparse_storage_get(
+    const ecs_world_t *world,
+    ecs_id_t id)
+{
+    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Fast path for when the application doesn't use sparse storage */
+    if (!world->store.sparse_ids) {
+        return NULL;
+    }
+
+    ecs_id_record_t *idr = ecs_get_id_record(world, id);
+    if (!idr) {
+        return NULL;
+    }
+
+    return idr->sparse;
+}
+
+void* ecs_sparse_storage_get_ptr(
+    ecs_sparse_t *storage,
+    ecs_entity_t entity)
+{
+    ecs_assert(storage != NULL, ECS_INTERNAL_ERROR, NULL);
+    return _ecs_sparse_get_sparse_any(storage, 0, (uint32_t)entity);
+}
+
+void* ecs_sparse_storage_ensure(
+    ecs_world_t *world,
+    ecs_sparse_t *storage,
+    ecs_id_t id,
+    ecs_entity_t entity,
+    bool construct,
+    bool *is_added)
+{
+    ecs_assert(storage != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    uint64_t index = (uint32_t)entity;
+    void *ptr = _ecs_sparse_get_sparse_any(storage, 0, index);
+    if (ptr) {
+        if (is_added) {
+            *is_added = false;
+        }
+        return ptr;
+    }
+
+    ptr = _ecs_sparse_ensure(storage, 0, index);
+    ecs_assert(ptr != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (construct) {
+        const ecs_type_info_t *c_info = storage_type_info(world, id);
+        ecs_xtor_t ctor;
+        if (c_info && (ctor = c_info->lifecycle.ctor)) {
+            ctor(world, c_info->component, &entity, ptr,
+                ecs_to_size_t(storage_elem_size(world, id)), 1,
+                c_info->lifecycle.ctx);
+        }
+    }
+
+    if (is_added) {
+        *is_added = true;
+    }
+
+    return ptr;
+}
+
+bool ecs_sparse_storage_remove(
+    ecs_world_t *world,
+    ecs_sparse_t *storage,
+    ecs_id_t id,
+    ecs_entity_t entity)
+{
+    ecs_assert(storage != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    uint64_t index = (uint32_t)entity;
+    void *ptr = _ecs_sparse_get_sparse_any(storage, 0, index);
+    if (!ptr) {
+        return false;
+    }
+
+    ecs_size_t size = storage_elem_size(world, id);
+    if (size) {
+        storage_dtor(world, storage_type_info(world, id), entity, ptr, size);
+    }
+
+    /* The generation stored in the sparse set is increased on each remove, so
+     * lookup the current index before removing it */
+    ecs_sparse_remove(storage, ecs_sparse_get_current(storage, index));
+
+    return true;
+}
+
+void ecs_sparse_storage_clear(
+    ecs_world_t *world,
+    ecs_entity_t entity)
+{
+    ecs_vector_t *sparse_ids = world->store.sparse_ids;
+    if (!sparse_ids) {
+        return;
+    }
+
+    ecs_id_t *ids = ecs_vector_first(sparse_ids, ecs_id_t);
+    int32_t i, count = ecs_vector_count(sparse_ids);
+    for (i = 0; i < count; i ++) {
+        ecs_id_t id = ids[i];
+        ecs_sparse_t *storage = ecs_sparse_storage_get(world, id);
+        ecs_assert(storage != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_sparse_storage_remove(world, storage, id, entity);
+    }
+}
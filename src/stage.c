@@ -70,6 +70,40 @@ bool defer_add_remove(
     return false;
 }
 
+/* Refill the block of reserved ids of a stage. The number of reserved ids is
+ * based on how many ids the stage created since the last merge, so stages that
+ * don't create entities don't hold on to ids. Ids are taken from the entity
+ * index, which means that ids of deleted entities are recycled. */
+static
+void reserve_stage_ids(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    int32_t target = stage->ids_created;
+    int32_t i, count = ecs_vector_count(stage->id_block);
+    for (i = count; i < target; i ++) {
+        ecs_entity_t *elem = ecs_vector_add(&stage->id_block, ecs_entity_t);
+        *elem = ecs_eis_recycle(world);
+    }
+
+    stage->ids_created = 0;
+}
+
+/* Return reserved ids to the entity index */
+static
+void release_stage_ids(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    ecs_entity_t *ids = ecs_vector_first(stage->id_block, ecs_entity_t);
+    int32_t i, count = ecs_vector_count(stage->id_block);
+    for (i = 0; i < count; i ++) {
+        ecs_eis_delete(world, ids[i]);
+    }
+
+    ecs_vector_clear(stage->id_block);
+}
+
 static
 void merge_stages(
     ecs_world_t *world,
@@ -91,6 +125,7 @@ void merge_stages(
          * a single stage. */
         if (force_merge || stage->auto_merge) {
             ecs_defer_end((ecs_world_t*)stage);
+            reserve_stage_ids(world, stage);
         }
     } else {
         /* Merge stages. Only merge if the stage has auto_merging turned on, or 
@@ -101,6 +136,7 @@ void merge_stages(
             ecs_assert(s->magic == ECS_STAGE_MAGIC, ECS_INTERNAL_ERROR, NULL);
             if (force_merge || s->auto_merge) {
                 ecs_defer_end((ecs_world_t*)s);
+                reserve_stage_ids(world, s);
             }
         }
     }
@@ -257,7 +293,7 @@ bool ecs_defer_bulk_new(
         /* Use ecs_new_id as this is thread safe */
         int i;
         for (i = 0; i < count; i ++) {
-            ids[i] = ecs_new_id(world);
+            ids[i] = ecs_new_id((ecs_world_t*)stage);
         }
 
         /* Create private copy for component data */
@@ -454,6 +490,7 @@ void ecs_stage_deinit(
     stage->magic = 0;
 
     ecs_vector_free(stage->defer_queue);
+    ecs_vector_free(stage->id_block);
 }
 
 void ecs_set_stages(
@@ -476,6 +513,13 @@ void ecs_set_stages(
             ecs_assert(stages[i].magic == ECS_STAGE_MAGIC, 
                 ECS_INTERNAL_ERROR, NULL);
             ecs_assert(stages[i].thread == 0, ECS_INVALID_OPERATION, NULL);
+
+            /* The entity index is already cleaned up when the world is being
+             * deleted, so only return ids while it's still alive */
+            if (!world->is_fini) {
+                release_stage_ids(world, &stages[i]);
+            }
+
             ecs_stage_deinit(world, &stages[i]);
         }
 
@@ -552,6 +596,11 @@ bool ecs_staging_begin(
     ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
 
+    /* Apply table deactivations while the world can still be mutated */
+    if (!world->is_readonly) {
+        ecs_world_deactivate_tables(world);
+    }
+
     int32_t i, count = ecs_get_stage_count(world);
     for (i = 0; i < count; i ++) {
         ecs_defer_begin(ecs_get_stage(world, i));
@@ -663,6 +712,9 @@ void ecs_async_stage_free(
     ecs_assert(world->magic == ECS_STAGE_MAGIC, ECS_INVALID_PARAMETER, NULL);
     ecs_stage_t *stage = (ecs_stage_t*)world;
     ecs_assert(stage->asynchronous == true, ECS_INVALID_PARAMETER, NULL);
+    if (!stage->world->is_fini) {
+        release_stage_ids(stage->world, stage);
+    }
     ecs_stage_deinit(stage->world, stage);
     ecs_os_free(stage);
 }
@@ -203,7 +203,7 @@ void run_on_remove(
 {
     int32_t count = ecs_vector_count(data->entities);
     if (count) {
-        ecs_run_monitors(world, table, table->un_set_all, 0, count, NULL);
+        ecs_run_monitors(world, table, &table->un_set_all, 0, count, NULL);
 
         int32_t i, type_count = ecs_vector_count(table->type);
         ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
@@ -240,14 +240,14 @@ int compare_matched_query(
 
 static
 void add_monitor(
-    ecs_vector_t **array,
+    ecs_small_vector_t *array,
     ecs_query_t *query,
     int32_t matched_table_index)
 {
     /* Add the system to a list that contains all OnSet systems matched with
      * this table. This makes it easy to get the list of systems that need to be
      * executed when all components are set, like when new_w_data is used */
-    ecs_matched_query_t *m = ecs_vector_add(array, ecs_matched_query_t);
+    ecs_matched_query_t *m = ecs_small_vector_add(array, ecs_matched_query_t);
     ecs_assert(m != NULL, ECS_INTERNAL_ERROR, NULL);
 
     m->query = query;
@@ -256,8 +256,8 @@ void add_monitor(
     /* Sort the system list so that it is easy to get the difference OnSet
      * OnSet systems between two tables. */
     qsort(
-        ecs_vector_first(*array, ecs_matched_query_t), 
-        ecs_to_size_t(ecs_vector_count(*array)),
+        ecs_small_vector_first(array), 
+        ecs_to_size_t(ecs_small_vector_count(array)),
         ECS_SIZEOF(ecs_matched_query_t), 
         compare_matched_query);
 }
@@ -278,7 +278,7 @@ void register_monitor(
     /* First check if system is already registered as monitor. It is possible
      * the query just wants to update the matched_table_index (for example, if
      * query tables got reordered) */
-    ecs_vector_each(table->monitors, ecs_matched_query_t, m, {
+    ecs_small_vector_each(&table->monitors, ecs_matched_query_t, m, {
         if (m->query == query) {
             m->matched_table_index = matched_table_index;
             return;
@@ -332,8 +332,8 @@ void register_on_set(
 
     if (table->column_count) {
         if (!table->on_set) {
-            table->on_set = 
-                ecs_os_calloc(ECS_SIZEOF(ecs_vector_t) * table->column_count);
+            table->on_set = ecs_os_calloc(
+                ECS_SIZEOF(ecs_small_vector_t) * table->column_count);
         }
 
         /* Get the matched table which holds the list of actual components */
@@ -376,11 +376,10 @@ void register_on_set(
                 continue;
             }
             
-            ecs_vector_t *set_c = table->on_set[index];
-            ecs_matched_query_t *m = ecs_vector_add(&set_c, ecs_matched_query_t);
+            ecs_matched_query_t *m = ecs_small_vector_add(
+                &table->on_set[index], ecs_matched_query_t);
             m->query = query;
             m->matched_table_index = matched_table_index;
-            table->on_set[index] = set_c;
             
             match_override |= is_override(world, table, comp);
         } 
@@ -422,9 +421,9 @@ void ecs_table_activate(
             .table = table
         });
     } else {
-        ecs_vector_t *queries = table->queries;
-        ecs_query_t **buffer = ecs_vector_first(queries, ecs_query_t*);
-        int32_t i, count = ecs_vector_count(queries);
+        ecs_query_t **buffer = ecs_small_vector_first_t(
+            &table->queries, ecs_query_t*);
+        int32_t i, count = ecs_small_vector_count(&table->queries);
 
         for (i = 0; i < count; i ++) {
             ecs_query_notify(world, buffer[i], &(ecs_query_event_t) {
@@ -435,6 +434,99 @@ void ecs_table_activate(
     }     
 }
 
+static
+void update_parent(
+    ecs_parent_record_t *parent,
+    ecs_table_t *table,
+    int32_t prev_count,
+    int32_t count)
+{
+    parent->child_count += count - prev_count;
+    ecs_assert(parent->child_count >= 0, ECS_INTERNAL_ERROR, NULL);
+
+    if (!prev_count == !count) {
+        return;
+    }
+
+    /* Tables are ordered by id, so that scope iterators can continue after
+     * the last iterated table when the list changes while iterating. */
+    int32_t table_count = ecs_vector_count(parent->tables);
+    int32_t t = ecs_parent_table_lower_bound(parent, table->id);
+
+    if (!prev_count) {
+        ecs_vector_add(&parent->tables, ecs_table_t*);
+        ecs_table_t **tables = ecs_vector_first(parent->tables, ecs_table_t*);
+        ecs_os_memmove(&tables[t + 1], &tables[t], 
+            (table_count - t) * ECS_SIZEOF(ecs_table_t*));
+        tables[t] = table;
+    } else {
+        ecs_table_t **tables = ecs_vector_first(parent->tables, ecs_table_t*);
+        ecs_assert(t < table_count, ECS_INTERNAL_ERROR, NULL);
+        ecs_assert(tables[t] == table, ECS_INTERNAL_ERROR, NULL);
+        ecs_os_memmove(&tables[t], &tables[t + 1], 
+            (table_count - t - 1) * ECS_SIZEOF(ecs_table_t*));
+        ecs_vector_remove_last(parent->tables);
+    }
+}
+
+void ecs_table_update_parents(
+    ecs_table_t *table,
+    int32_t count)
+{
+    int32_t i, parent_count = ecs_small_vector_count(&table->parents);
+    int32_t prev_count = table->child_count;
+    if (!parent_count || prev_count == count) {
+        return;
+    }
+
+    table->child_count = count;
+
+    ecs_parent_record_t **parents = ecs_small_vector_first_t(
+        &table->parents, ecs_parent_record_t*);
+    for (i = 0; i < parent_count; i ++) {
+        update_parent(parents[i], table, prev_count, count);
+    }
+}
+
+void ecs_table_add_parent(
+    ecs_table_t *table,
+    ecs_parent_record_t *parent)
+{
+    if (!ecs_small_vector_count(&table->parents)) {
+        table->child_count = ecs_table_count(table);
+    }
+
+    ecs_parent_record_t **elem = ecs_small_vector_add(
+        &table->parents, ecs_parent_record_t*);
+    *elem = parent;
+
+    update_parent(parent, table, 0, table->child_count);
+}
+
+int32_t ecs_parent_table_lower_bound(
+    const ecs_parent_record_t *parent,
+    uint64_t table_id)
+{
+    ecs_table_t **tables = ecs_vector_first(parent->tables, ecs_table_t*);
+    int32_t lo = 0, hi = ecs_vector_count(parent->tables);
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (tables[mid]->id < table_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void ecs_table_clear_parents(
+    ecs_table_t *table)
+{
+    ecs_table_update_parents(table, 0);
+    ecs_small_vector_free(&table->parents);
+}
+
 /* This function is called when a query is matched with a table. A table keeps
  * a list of tables that match so that they can be notified when the table
  * becomes empty / non-empty. */
@@ -449,14 +541,15 @@ void register_query(
     if (!(query->flags & EcsQueryNoActivation)) {
 #ifndef NDEBUG
         /* Sanity check if query has already been added */
-        int32_t i, count = ecs_vector_count(table->queries);
+        int32_t i, count = ecs_small_vector_count(&table->queries);
         for (i = 0; i < count; i ++) {
-            ecs_query_t **q = ecs_vector_get(table->queries, ecs_query_t*, i);
+            ecs_query_t **q = ecs_small_vector_get(
+                &table->queries, ecs_query_t*, i);
             ecs_assert(*q != query, ECS_INTERNAL_ERROR, NULL);
         }
 #endif
 
-        ecs_query_t **q = ecs_vector_add(&table->queries, ecs_query_t*);
+        ecs_query_t **q = ecs_small_vector_add(&table->queries, ecs_query_t*);
         if (q) *q = query;
 
         ecs_data_t *data = ecs_table_get_data(table);
@@ -494,9 +587,10 @@ void unregister_query(
     (void)world;
 
     if (!(query->flags & EcsQueryNoActivation)) {
-        int32_t i, count = ecs_vector_count(table->queries);
+        int32_t i, count = ecs_small_vector_count(&table->queries);
         for (i = 0; i < count; i ++) {
-            ecs_query_t **q = ecs_vector_get(table->queries, ecs_query_t*, i);
+            ecs_query_t **q = ecs_small_vector_get(
+                &table->queries, ecs_query_t*, i);
             if (*q == query) {
                 break;
             }
@@ -506,7 +600,7 @@ void unregister_query(
         ecs_assert(i != count, ECS_INTERNAL_ERROR, NULL);
 
         /* Remove query */
-        ecs_vector_remove(table->queries, ecs_query_t*, i);        
+        ecs_small_vector_remove(&table->queries, ecs_query_t*, i);
     }
 }
 
@@ -630,6 +724,7 @@ void dtor_all_components(
                     ECS_INTERNAL_ERROR, NULL);
 
                 if (is_delete) {
+                    ecs_sparse_storage_clear(world, e);
                     ecs_eis_delete(world, e);
                     ecs_assert(ecs_is_valid(world, e) == false, 
                         ECS_INTERNAL_ERROR, NULL);
@@ -659,6 +754,7 @@ void dtor_all_components(
                 ecs_assert(!e || records[i]->table == table, 
                     ECS_INTERNAL_ERROR, NULL);
 
+                ecs_sparse_storage_clear(world, e);
                 ecs_eis_delete(world, e);
                 ecs_assert(!ecs_is_valid(world, e), ECS_INTERNAL_ERROR, NULL);
             } 
@@ -703,6 +799,11 @@ void fini_data(
             update_entity_index, is_delete);
     }
 
+    /* Data can be a copy, as is the case for snapshots */
+    if (data == table->data) {
+        ecs_table_update_parents(table, 0);
+    }
+
     /* Sanity check */
     ecs_assert(ecs_vector_count(data->record_ptrs) == 
         ecs_vector_count(data->entities), ECS_INTERNAL_ERROR, NULL);
@@ -805,7 +906,6 @@ void ecs_table_free(
     ecs_table_t *table)
 {
     ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
-    (void)world;
 
     /* Cleanup data, no OnRemove, delete from entity index, don't deactivate */
     ecs_data_t *data = ecs_table_get_data(table);
@@ -817,12 +917,17 @@ void ecs_table_free(
 
     ecs_os_free(table->lo_edges);
     ecs_map_free(table->hi_edges);
-    ecs_vector_free(table->queries);
+    ecs_small_vector_free(&table->queries);
     ecs_os_free(table->dirty_state);
-    ecs_vector_free(table->monitors);
-    ecs_vector_free(table->on_set_all);
-    ecs_vector_free(table->on_set_override);
-    ecs_vector_free(table->un_set_all);
+    ecs_small_vector_free(&table->monitors);
+    ecs_small_vector_free(&table->on_set_all);
+    ecs_small_vector_free(&table->on_set_override);
+    ecs_small_vector_free(&table->un_set_all);
+    ecs_table_clear_triggers(table);
+    ecs_map_free(table->base_cache);
+
+    /* Other tables may have cached components of bases in this table */
+    world->base_version ++;
 
     if (table->c_info) {
         ecs_os_free(table->c_info);
@@ -831,7 +936,7 @@ void ecs_table_free(
     if (table->on_set) {
         int32_t i;
         for (i = 0; i < table->column_count; i ++) {
-            ecs_vector_free(table->on_set[i]);
+            ecs_small_vector_free(&table->on_set[i]);
         }
         ecs_os_free(table->on_set);
     }
@@ -1094,7 +1199,7 @@ void grow_column(
     } else {
         /* If array won't realloc or has no move, simply add new elements */
         if (can_realloc) {
-            ecs_vector_set_size_t(&vec, size, alignment, new_size);
+            ecs_vector_reserve_t(&vec, size, alignment, new_size);
         }
 
         void *elem = ecs_vector_addn_t(&vec, size, alignment, to_add);
@@ -1137,7 +1242,7 @@ int32_t grow_data(
         &bs_column_count, &columns, &sw_columns, &bs_columns);    
 
     /* Add record to record ptr array */
-    ecs_vector_set_size(&data->record_ptrs, ecs_record_t*, size);
+    ecs_vector_reserve(&data->record_ptrs, ecs_record_t*, size);
     ecs_record_t **r = ecs_vector_addn(&data->record_ptrs, ecs_record_t*, to_add);
     ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
     if (ecs_vector_size(data->record_ptrs) > size) {
@@ -1145,7 +1250,7 @@ int32_t grow_data(
     }
 
     /* Add entity to column with entity ids */
-    ecs_vector_set_size(&data->entities, ecs_entity_t, size);
+    ecs_vector_reserve(&data->entities, ecs_entity_t, size);
     ecs_entity_t *e = ecs_vector_addn(&data->entities, ecs_entity_t, to_add);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(ecs_vector_size(data->entities) == size, ECS_INTERNAL_ERROR, NULL);
@@ -1199,12 +1304,90 @@ int32_t grow_data(
         ecs_table_activate(world, table, 0, true);
     }
 
+    ecs_table_update_parents(table, cur_count + to_add);
+
     table->alloc_count ++;
 
     /* Return index of first added entity */
     return cur_count;
 }
 
+/* Compute the new size of table storage that is full, according to the growth
+ * policy of the table or the world. */
+static
+int32_t grow_size(
+    const ecs_world_t *world,
+    const ecs_table_t *table,
+    int32_t size,
+    int32_t min_size)
+{
+    const ecs_growth_policy_t *policy = &table->growth_policy;
+    if (!policy->factor) {
+        policy = &world->growth_policy;
+    }
+
+    int32_t result;
+    if (policy->linear_threshold && policy->linear_step && 
+        size >= policy->linear_threshold) 
+    {
+        result = size + policy->linear_step;
+    } else if (!size) {
+        result = 2;
+    } else {
+        result = (int32_t)((float)size * policy->factor);
+        if (result <= size) {
+            result = size + 1;
+        }
+    }
+
+    if (result < min_size) {
+        result = min_size;
+    }
+
+    if (policy->max_slack && (result - min_size) > policy->max_slack) {
+        result = min_size + policy->max_slack;
+    }
+
+    return result;
+}
+
+/* Grow table storage to the provided size without adding elements */
+static
+void reserve_data(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    ecs_column_t *columns,
+    int32_t column_count,
+    int32_t size)
+{
+    if (ecs_vector_size(data->entities) >= size) {
+        return;
+    }
+
+    ecs_vector_reserve(&data->entities, ecs_entity_t, size);
+    ecs_vector_reserve(&data->record_ptrs, ecs_record_t*, size);
+
+    ecs_type_info_t **c_info_array = table->c_info;
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    int32_t i;
+    for (i = 0; i < column_count; i ++) {
+        ecs_column_t *column = &columns[i];
+        if (!column->size) {
+            continue;
+        }
+
+        ecs_type_info_t *c_info = NULL;
+        if (c_info_array) {
+            c_info = c_info_array[i];
+        }
+
+        grow_column(world, entities, column, c_info, 0, size, false);
+    }
+
+    table->alloc_count ++;
+}
+
 static
 void fast_append(
     ecs_column_t *columns,
@@ -1249,6 +1432,16 @@ int32_t ecs_table_append(
     ensure_data(world, table, data, &column_count, &sw_column_count,
         &bs_column_count, &columns, &sw_columns, &bs_columns);
 
+    /* If storage is full, grow it according to the growth policy. Vectors
+     * double in size when they're full, so only reserve storage explicitly if
+     * the policy computes a different size. */
+    if (count == size) {
+        int32_t new_size = grow_size(world, table, size, count + 1);
+        if (new_size != (size ? size * 2 : 2)) {
+            reserve_data(world, table, data, columns, column_count, new_size);
+        }
+    }
+
     /* Grow buffer with entity ids, set new element to new entity */
     ecs_entity_t *e = ecs_vector_add(&data->entities, ecs_entity_t);
     ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
@@ -1272,6 +1465,8 @@ int32_t ecs_table_append(
         ecs_table_activate(world, table, 0, true);
     } 
 
+    ecs_table_update_parents(table, count + 1);
+
     ecs_assert(count >= 0, ECS_INTERNAL_ERROR, NULL);
 
     /* Fast path: no switch columns, no lifecycle actions */
@@ -1416,6 +1611,8 @@ void ecs_table_delete(
         ecs_table_activate(world, table, NULL, false);
     }
 
+    ecs_table_update_parents(table, count);
+
     /* Destruct component data */
     ecs_type_info_t **c_info_array = table->c_info;
     ecs_column_t *columns = data->columns;
@@ -1502,6 +1699,158 @@ void ecs_table_delete(
     }
 }
 
+void ecs_table_delete_rows(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    const int32_t *rows,
+    int32_t row_count,
+    bool destruct)
+{
+    ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(rows != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
+
+    /* Switch and bitset columns don't support removing multiple elements */
+    ecs_assert(!(table->flags & (EcsTableHasSwitch | EcsTableHasDisabled)),
+        ECS_INTERNAL_ERROR, NULL);
+
+    if (!row_count) {
+        return;
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    ecs_record_t **records = ecs_vector_first(data->record_ptrs, ecs_record_t*);
+    int32_t count = ecs_vector_count(data->entities);
+    int32_t new_count = count - row_count;
+    ecs_assert(new_count >= 0, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(rows[row_count - 1] < count, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_type_info_t **c_info_array = table->c_info;
+    ecs_column_t *columns = data->columns;
+    int32_t column_count = table->column_count;
+    int32_t i, c;
+
+    bool has_dtors = destruct && (table->flags & EcsTableHasDtors);
+    bool has_move_dtors = destruct && 
+        (table->flags & (EcsTableHasDtors | EcsTableHasMove));
+
+    /* Find first deleted row that is not going to be overwritten */
+    int32_t tail = row_count;
+    while (tail && rows[tail - 1] >= new_count) {
+        tail --;
+    }
+
+    /* Destruct rows that are not overwritten, per range of consecutive rows */
+    if (has_dtors) {
+        ecs_assert(c_info_array != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        for (i = tail; i < row_count; ) {
+            int32_t first = rows[i ++], last = first + 1;
+            while (i < row_count && rows[i] == last) {
+                last ++;
+                i ++;
+            }
+
+            for (c = 0; c < column_count; c ++) {
+                ecs_type_info_t *c_info = c_info_array[c];
+                ecs_xtor_t dtor;
+                if (c_info && (dtor = c_info->lifecycle.dtor)) {
+                    ecs_column_t *column = &columns[c];
+                    ecs_size_t size = column->size;
+                    void *ptr = ecs_vector_get_t(
+                        column->data, size, column->alignment, first);
+                    dtor(world, c_info->component, &entities[first], ptr,
+                        ecs_to_size_t(size), last - first, 
+                        c_info->lifecycle.ctx);
+                }
+            }
+        }
+    }
+
+    /* Fill the remaining deleted rows with entities from the end of the table
+     * that are not deleted. This requires at most one move per entity. */
+    int32_t src = count - 1, del = row_count - 1;
+    for (i = 0; i < tail; i ++) {
+        int32_t dst = rows[i];
+
+        while (del >= 0 && rows[del] == src) {
+            del --;
+            src --;
+        }
+
+        ecs_assert(src >= new_count, ECS_INTERNAL_ERROR, NULL);
+
+        ecs_entity_t entity_to_move = entities[src];
+        ecs_entity_t entity_to_delete = entities[dst];
+
+        for (c = 0; c < column_count; c ++) {
+            ecs_column_t *column = &columns[c];
+            ecs_size_t size = column->size;
+            if (!size) {
+                continue;
+            }
+
+            ecs_size_t align = column->alignment;
+            void *dst_ptr = ecs_vector_get_t(column->data, size, align, dst);
+            void *src_ptr = ecs_vector_get_t(column->data, size, align, src);
+
+            ecs_type_info_t *c_info = c_info_array ? c_info_array[c] : NULL;
+            ecs_move_ctor_t move_dtor;
+            if (has_move_dtors && c_info && 
+                (move_dtor = c_info->lifecycle.move_dtor)) 
+            {
+                move_dtor(world, c_info->component, &c_info->lifecycle,
+                    &entity_to_move, &entity_to_delete, dst_ptr, src_ptr, 
+                    ecs_to_size_t(size), 1, c_info->lifecycle.ctx);
+            } else {
+                ecs_os_memcpy(dst_ptr, src_ptr, size);
+            }
+        }
+
+        entities[dst] = entity_to_move;
+
+        ecs_record_t *record_to_move = records[src];
+        records[dst] = record_to_move;
+
+        /* Update record of moved entity in entity index */
+        if (record_to_move) {
+            if (record_to_move->row >= 0) {
+                record_to_move->row = dst + 1;
+            } else {
+                record_to_move->row = -(dst + 1);
+            }
+            ecs_assert(record_to_move->table == table, 
+                ECS_INTERNAL_ERROR, NULL);
+        }
+
+        src --;
+    }
+
+    ecs_vector_set_count(&data->entities, ecs_entity_t, new_count);
+    ecs_vector_set_count(&data->record_ptrs, ecs_record_t*, new_count);
+
+    for (c = 0; c < column_count; c ++) {
+        ecs_column_t *column = &columns[c];
+        if (column->size) {
+            ecs_vector_set_count_t(
+                &column->data, column->size, column->alignment, new_count);
+        }
+    }
+
+    /* If the table is monitored indicate that there has been a change */
+    mark_table_dirty(table, 0);
+
+    /* If table is empty, deactivate it */
+    if (!new_count) {
+        ecs_table_activate(world, table, NULL, false);
+    }
+
+    ecs_table_update_parents(table, new_count);
+}
+
 static
 void fast_move(
     ecs_table_t * new_table,
@@ -1676,7 +2025,12 @@ int32_t ecs_table_appendn(
     ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
 
     int32_t cur_count = ecs_table_data_count(data);
-    return grow_data(world, table, data, to_add, cur_count + to_add, ids);
+    int32_t size = ecs_vector_size(data->entities);
+    if ((cur_count + to_add) > size) {
+        size = grow_size(world, table, size, cur_count + to_add);
+    }
+
+    return grow_data(world, table, data, to_add, size, ids);
 }
 
 void ecs_table_set_size(
@@ -1705,6 +2059,126 @@ void ecs_table_set_size(
     }
 }
 
+static
+int64_t compact_column(
+    ecs_world_t *world,
+    ecs_entity_t *entities,
+    ecs_column_t *column,
+    ecs_type_info_t *c_info)
+{
+    ecs_vector_t *vec = column->data;
+    int16_t alignment = column->alignment;
+    int32_t size = column->size;
+    int32_t count = ecs_vector_count(vec);
+    int32_t old_size = ecs_vector_size(vec);
+
+    if (count == old_size) {
+        return 0;
+    }
+
+    /* If the component has a move action, elements can't be reallocated and
+     * have to be moved to a new vector, like when a column grows. */
+    ecs_move_t move;
+    if (c_info && count && (move = c_info->lifecycle.move)) {
+        ecs_xtor_t ctor = c_info->lifecycle.ctor;
+        ecs_assert(ctor != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        ecs_vector_t *new_vec = ecs_vector_new_t(size, alignment, count);
+        ecs_vector_set_count_t(&new_vec, size, alignment, count);
+
+        void *old_buffer = ecs_vector_first_t(vec, size, alignment);
+        void *new_buffer = ecs_vector_first_t(new_vec, size, alignment);
+
+        ctor(world, c_info->component, entities, new_buffer,
+            ecs_to_size_t(size), count, c_info->lifecycle.ctx);
+        move(world, c_info->component, entities, entities,
+            new_buffer, old_buffer, ecs_to_size_t(size), count,
+            c_info->lifecycle.ctx);
+
+        ecs_vector_free(vec);
+        column->data = new_vec;
+    } else {
+        ecs_vector_reclaim_t(&column->data, size, alignment);
+    }
+
+    return (old_size - count) * size;
+}
+
+void ecs_table_reserve(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_data_t *data,
+    int32_t size)
+{
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(data != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
+
+    int32_t column_count = table->column_count;
+    int32_t sw_column_count = table->sw_column_count;
+    int32_t bs_column_count = table->bs_column_count;
+    ecs_column_t *columns = NULL;
+    ecs_sw_column_t *sw_columns = NULL;
+    ecs_bs_column_t *bs_columns = NULL;
+    ensure_data(world, table, data, &column_count, &sw_column_count,
+        &bs_column_count, &columns, &sw_columns, &bs_columns);
+
+    reserve_data(world, table, data, columns, column_count, size);
+}
+
+int64_t ecs_table_compact(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(!table->lock, ECS_LOCKED_STORAGE, NULL);
+
+    ecs_data_t *data = table->data;
+    if (!data || !data->entities) {
+        return 0;
+    }
+
+    int64_t freed = 0;
+    int32_t count = ecs_vector_count(data->entities);
+    int32_t size = ecs_vector_size(data->entities);
+    if (count == size) {
+        return 0;
+    }
+
+    ecs_vector_reclaim(&data->entities, ecs_entity_t);
+    freed += (size - count) * ECS_SIZEOF(ecs_entity_t);
+
+    if (data->record_ptrs) {
+        size = ecs_vector_size(data->record_ptrs);
+        ecs_vector_reclaim(&data->record_ptrs, ecs_record_t*);
+        freed += (size - count) * ECS_SIZEOF(ecs_record_t*);
+    }
+
+    ecs_entity_t *entities = ecs_vector_first(data->entities, ecs_entity_t);
+    ecs_type_info_t **c_info_array = table->c_info;
+    ecs_column_t *columns = data->columns;
+    int32_t i, column_count = table->column_count;
+
+    for (i = 0; columns && i < column_count; i ++) {
+        ecs_column_t *column = &columns[i];
+        if (!column->size || !column->data) {
+            continue;
+        }
+
+        ecs_type_info_t *c_info = NULL;
+        if (c_info_array) {
+            c_info = c_info_array[i];
+        }
+
+        freed += compact_column(world, entities, column, c_info);
+    }
+
+    /* Component pointers into the table are no longer valid */
+    table->alloc_count ++;
+
+    return freed;
+}
+
 int32_t ecs_table_data_count(
     const ecs_data_t *data)
 {
@@ -2110,6 +2584,11 @@ ecs_data_t* ecs_table_merge(
     ecs_record_t **old_records = ecs_vector_first(
         old_data->record_ptrs, ecs_record_t*);
 
+    /* Entities may end up in a different scope */
+    if (new_table != old_table) {
+        ecs_name_index_touch_table(world, new_table, old_data);
+    }
+
     /* First, update entity index so old entities point to new type */
     int32_t i;
     for(i = 0; i < old_count; i ++) {
@@ -2126,6 +2605,9 @@ ecs_data_t* ecs_table_merge(
         record->table = new_table;
     }
 
+    /* Entities may be bases of which other tables cached components */
+    world->base_version ++;
+
     /* Merge table columns */
     if (move_data) {
         *new_data = *old_data;
@@ -2134,6 +2616,14 @@ ecs_data_t* ecs_table_merge(
             old_data, new_data);
     }
 
+    /* Old data can be a copy, as is the case for snapshots */
+    if (old_data != new_data) {
+        if (old_data == old_table->data) {
+            ecs_table_update_parents(old_table, 0);
+        }
+        ecs_table_update_parents(new_table, new_count + old_count);
+    }
+
     new_table->alloc_count ++;
 
     if (!new_count && old_count) {
@@ -2159,6 +2649,9 @@ void ecs_table_replace_data(
         ecs_table_clear_data(world, table, table_data);
     }
 
+    /* Entities may be bases of which other tables cached components */
+    world->base_version ++;
+
     if (data) {
         table_data = ecs_table_get_or_create_data(table);
         *table_data = *data;
@@ -2166,7 +2659,10 @@ void ecs_table_replace_data(
         return;
     }
 
+    ecs_name_index_touch_table(world, table, table_data);
+
     int32_t count = ecs_table_count(table);
+    ecs_table_update_parents(table, count);
 
     if (!prev_count && count) {
         ecs_table_activate(world, table, 0, true);
@@ -310,18 +310,19 @@ void init_table(
     table->data = NULL;
     table->flags = 0;
     table->dirty_state = NULL;
-    table->monitors = NULL;
+    table->monitors = (ecs_small_vector_t){0};
     table->on_set = NULL;
-    table->on_set_all = NULL;
-    table->on_set_override = NULL;
-    table->un_set_all = NULL;
+    table->on_set_all = (ecs_small_vector_t){0};
+    table->on_set_override = (ecs_small_vector_t){0};
+    table->un_set_all = (ecs_small_vector_t){0};
     table->alloc_count = 0;
+    table->growth_policy = (ecs_growth_policy_t){0};
     table->lock = 0;
 
     /* Ensure the component ids for the table exist */
     ensure_columns(world, table);
 
-    table->queries = NULL;
+    table->queries = (ecs_small_vector_t){0};
     table->column_count = data_column_count(world, table);
     table->sw_column_count = switch_column_count(table);
     table->bs_column_count = bitset_column_count(table);
@@ -332,8 +333,7 @@ void init_table(
 static
 ecs_table_t *create_table(
     ecs_world_t * world,
-    ecs_ids_t * entities,
-    ecs_hashmap_result_t table_elem)
+    ecs_ids_t * entities)
 {
     ecs_table_t *result = ecs_sparse_add(world->store.tables, ecs_table_t);
     result->id = ecs_sparse_last_id(world->store.tables);
@@ -348,14 +348,19 @@ ecs_table_t *create_table(
 #endif
     ecs_log_push();
 
-    /* Store table in table hashmap */
-    *(ecs_table_t**)table_elem.value = result;
-
     /* Set keyvalue to one that has the same lifecycle as the table */
     ecs_ids_t key = {
         .array = ecs_vector_first(result->type, ecs_id_t),
         .count = ecs_vector_count(result->type)
     };
+
+    /* Elements in the table hashmap move when it is rehashed, so get the
+     * element after initializing the table, which can create other tables. */
+    ecs_hashmap_result_t table_elem = ecs_hashmap_ensure(
+        world->store.table_map, &key, ecs_table_t*);
+
+    /* Store table in table hashmap */
+    *(ecs_table_t**)table_elem.value = result;
     *(ecs_ids_t*)table_elem.key = key;
 
     ecs_notify_queries(world, &(ecs_query_event_t) {
@@ -899,7 +904,7 @@ ecs_table_t* find_or_create(
 #endif
 
     /* If we get here, the table has not been found, so create it. */
-    ecs_table_t *result = create_table(world, &ordered_ids, elem);
+    ecs_table_t *result = create_table(world, &ordered_ids);
     
     ecs_assert(ordered_ids.count == ecs_vector_count(result->type), 
         ECS_INTERNAL_ERROR, NULL);
@@ -937,6 +942,10 @@ void ecs_init_root_table(
     };
 
     init_table(world, &world->store.root, &entities);
+
+    /* The root table is not in the table storage, so make sure its id doesn't
+     * collide with the id of a stored table */
+    world->store.root.id = UINT64_MAX;
 }
 
 void ecs_table_clear_edges(
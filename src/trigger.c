@@ -85,6 +85,9 @@ void register_trigger(
 
         register_id_trigger(*set, trigger);
     }
+
+    /* Invalidate triggers cached by tables */
+    world->trigger_version ++;
 }
 
 static
@@ -126,7 +129,15 @@ void unregister_trigger(
         *set = unregister_id_trigger(*set, trigger);                
     }
 
-    ecs_map_remove(triggers, trigger->id);
+    /* Invalidate triggers cached by tables */
+    world->trigger_version ++;
+
+    /* Only remove id administration when no triggers for the id are left */
+    if (!idt->on_add_triggers && !idt->on_remove_triggers &&
+        !idt->on_set_triggers && !idt->un_set_triggers)
+    {
+        ecs_map_remove(triggers, trigger->term.id);
+    }
 }
 
 ecs_map_t* ecs_triggers_get(
@@ -164,18 +175,159 @@ ecs_map_t* ecs_triggers_get(
     }
 }
 
+static
+int32_t event_index(
+    ecs_entity_t event)
+{
+    if (event == EcsOnAdd) {
+        return 0;
+    } else if (event == EcsOnRemove) {
+        return 1;
+    } else if (event == EcsOnSet) {
+        return 2;
+    } else if (event == EcsUnSet) {
+        return 3;
+    }
+
+    /* Invalid event provided */
+    ecs_abort(ECS_INVALID_PARAMETER, NULL);
+}
+
+static
+void add_trigger_set(
+    ecs_small_vector_t *dst,
+    const ecs_map_t *triggers)
+{
+    ecs_map_iter_t mit = ecs_map_iter(triggers);
+    ecs_trigger_t *t;
+    while ((t = ecs_map_next_ptr(&mit, ecs_trigger_t*, NULL))) {
+        ecs_trigger_t **elem = ecs_small_vector_add(dst, ecs_trigger_t*);
+        *elem = t;
+    }
+}
+
+/* Get the ids of the trigger sets that match an id: the id itself, and the
+ * wildcards that match the id */
+static
+int32_t trigger_set_ids(
+    ecs_id_t id,
+    ecs_id_t *set_ids)
+{
+    set_ids[0] = id;
+
+    if (ECS_HAS_ROLE(id, PAIR)) {
+        set_ids[1] = ecs_pair(ECS_PAIR_RELATION(id), EcsWildcard);
+        set_ids[2] = ecs_pair(EcsWildcard, ECS_PAIR_OBJECT(id));
+        set_ids[3] = ecs_pair(EcsWildcard, EcsWildcard);
+        return 4;
+    } else {
+        set_ids[1] = EcsWildcard;
+        return 2;
+    }
+}
+
+/* Resolve triggers for each id in the table type for an event. This combines 
+ * the triggers for the id with the triggers for the wildcards that match the 
+ * id, so that notifying triggers doesn't require looking up the trigger sets
+ * each time an event occurs. */
+static
+ecs_small_vector_t* init_table_triggers(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_entity_t event)
+{
+    int32_t i, count = ecs_vector_count(table->type);
+    ecs_id_t *ids = ecs_vector_first(table->type, ecs_id_t);
+    ecs_small_vector_t *result = ecs_os_calloc(
+        ECS_SIZEOF(ecs_small_vector_t) * count);
+
+    for (i = 0; i < count; i ++) {
+        ecs_small_vector_t *dst = &result[i];
+        ecs_id_t set_ids[4];
+        int32_t s, set_count = trigger_set_ids(ids[i], set_ids);
+
+        for (s = 0; s < set_count; s ++) {
+            add_trigger_set(dst, ecs_triggers_get(world, set_ids[s], event));
+        }
+    }
+
+    return result;
+}
+
+/* Test whether a trigger is still registered for an id and event. Only compares
+ * pointers, so the trigger may already have been freed. */
+static
+bool trigger_is_registered(
+    const ecs_world_t *world,
+    ecs_id_t id,
+    ecs_entity_t event,
+    const ecs_trigger_t *trigger)
+{
+    ecs_id_t set_ids[4];
+    int32_t s, set_count = trigger_set_ids(id, set_ids);
+
+    for (s = 0; s < set_count; s ++) {
+        ecs_map_iter_t mit = ecs_map_iter(
+            ecs_triggers_get(world, set_ids[s], event));
+        ecs_trigger_t *t;
+        while ((t = ecs_map_next_ptr(&mit, ecs_trigger_t*, NULL))) {
+            if (t == trigger) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/* Get triggers for the id at the specified index in the table type. This 
+ * doesn't (re)build the cache, so that a trigger action that causes the cache
+ * to be rebuilt does not invalidate the triggers that are being iterated. */
+static
+ecs_small_vector_t* get_table_triggers(
+    ecs_table_t *table,
+    int32_t event_index,
+    int32_t index)
+{
+    ecs_small_vector_t *triggers = table->triggers[event_index];
+    if (!triggers) {
+        return NULL;
+    }
+
+    return &triggers[index];
+}
+
+void ecs_table_clear_triggers(
+    ecs_table_t *table)
+{
+    int32_t i, e, count = ecs_vector_count(table->type);
+    for (e = 0; e < ECS_TRIGGER_EVENT_COUNT; e ++) {
+        ecs_small_vector_t *triggers = table->triggers[e];
+        if (triggers) {
+            for (i = 0; i < count; i ++) {
+                ecs_small_vector_free(&triggers[i]);
+            }
+            ecs_os_free(triggers);
+            table->triggers[e] = NULL;
+        }
+    }
+}
+
 static
 void notify_trigger_set(
     ecs_world_t *world,
     ecs_entity_t id,
     ecs_entity_t event,
-    const ecs_map_t *triggers,
+    int32_t event_index,
+    int32_t type_index,
     ecs_table_t *table,
     ecs_data_t *data,
     int32_t row,
     int32_t count)
 {
-    if (!triggers) {
+    ecs_small_vector_t *triggers = get_table_triggers(
+        table, event_index, type_index);
+    if (!ecs_small_vector_count(triggers)) {
         return;
     }
 
@@ -189,9 +341,7 @@ void notify_trigger_set(
         ECS_INTERNAL_ERROR, NULL);
     entities = ECS_OFFSET(entities, ECS_SIZEOF(ecs_entity_t) * row);
 
-    int32_t index = ecs_type_index_of(table->type, id);
-    ecs_assert(index >= 0, ECS_INTERNAL_ERROR, NULL);
-    index ++;
+    int32_t index = type_index + 1;
 
     ecs_entity_t ids[1] = { id };
     int32_t columns[1] = { index };
@@ -229,15 +379,40 @@ void notify_trigger_set(
         .count = count
     }; 
 
-    ecs_map_iter_t mit = ecs_map_iter(triggers);
-    ecs_trigger_t *t;
-    while ((t = ecs_map_next_ptr(&mit, ecs_trigger_t*, NULL))) {
+    /* Copy the triggers, as trigger actions can (un)register triggers, which
+     * clears the cache of the table */
+    int32_t i, trigger_count = ecs_small_vector_count(triggers);
+    ecs_trigger_t *stack_list[ECS_TRIGGER_STACK_COUNT];
+    ecs_trigger_t **list = stack_list;
+    if (trigger_count > ECS_TRIGGER_STACK_COUNT) {
+        list = ecs_os_malloc(ECS_SIZEOF(ecs_trigger_t*) * trigger_count);
+    }
+    ecs_os_memcpy(list, ecs_small_vector_first(triggers), 
+        ECS_SIZEOF(ecs_trigger_t*) * trigger_count);
+
+    int32_t trigger_version = world->trigger_version;
+
+    for (i = 0; i < trigger_count; i ++) {
+        ecs_trigger_t *t = list[i];
+
+        /* If a trigger action (un)registered triggers, the remaining triggers
+         * in the list may have been deleted */
+        if (trigger_version != world->trigger_version) {
+            if (!trigger_is_registered(world, id, event, t)) {
+                continue;
+            }
+        }
+
         it.system = t->entity;
         it.self = t->self;
         it.ctx = t->ctx;
         it.binding_ctx = t->binding_ctx;
         it.term_index = t->term.index;
-        t->action(&it);                   
+        t->action(&it);
+    }
+
+    if (list != stack_list) {
+        ecs_os_free(list);
     }
 }
 
@@ -250,30 +425,23 @@ void ecs_triggers_notify(
     int32_t row,
     int32_t count)
 {
-    notify_trigger_set(world, id, event,
-        ecs_triggers_get(world, id, event), 
-            table, data, row, count);
-
-    if (ECS_HAS_ROLE(id, PAIR)) {
-        ecs_entity_t pred = ECS_PAIR_RELATION(id);
-        ecs_entity_t obj = ECS_PAIR_OBJECT(id);
-
-        notify_trigger_set(world, id, event,
-            ecs_triggers_get(world, ecs_pair(pred, EcsWildcard), event), 
-                table, data, row, count);
+    int32_t index = ecs_type_index_of(table->type, id);
+    if (index == -1) {
+        return;
+    }
 
-        notify_trigger_set(world, id, event, 
-            ecs_triggers_get(world, ecs_pair(EcsWildcard, obj), event), 
-                table, data, row, count);
+    /* Triggers were (un)registered since the cache was built */
+    if (table->trigger_version != world->trigger_version) {
+        ecs_table_clear_triggers(table);
+        table->trigger_version = world->trigger_version;
+    }
 
-        notify_trigger_set(world, id, event, 
-            ecs_triggers_get(world, ecs_pair(EcsWildcard, EcsWildcard), event), 
-                table, data, row, count);                                
-    } else {
-        notify_trigger_set(world, id, event, 
-            ecs_triggers_get(world, EcsWildcard, event), 
-                table, data, row, count);
+    int32_t e = event_index(event);
+    if (!table->triggers[e]) {
+        table->triggers[e] = init_table_triggers(world, table, event);
     }
+
+    notify_trigger_set(world, id, event, e, index, table, data, row, count);
 }
 
 ecs_entity_t ecs_trigger_init(
@@ -478,6 +478,12 @@ char* ecs_type_str(
             len = ecs_os_strlen("EcsComponent");
         } else {
             len = ecs_from_size_t(ecs_id_str(world, e, buffer, 256));
+
+            /* ecs_id_str returns the length of the full string, which can be
+             * longer than what fits in the buffer */
+            if (len > 255) {
+                len = 255;
+            }
         }
 
         dst = ecs_vector_addn(&chbuf, char, len);
@@ -312,6 +312,32 @@ int32_t _ecs_vector_set_size(
     }
 }
 
+int32_t _ecs_vector_reserve(
+    ecs_vector_t **array_inout,
+    ecs_size_t elem_size,
+    int16_t offset,
+    int32_t elem_count)
+{
+    ecs_vector_t *vector = *array_inout;
+
+    if (!vector) {
+        *array_inout = _ecs_vector_new(elem_size, offset, elem_count);
+        return elem_count;
+    }
+
+    ecs_assert(vector->elem_size == elem_size, ECS_INTERNAL_ERROR, NULL);
+
+    int32_t result = vector->size;
+    if (result < elem_count) {
+        vector = resize(vector, offset, elem_count * elem_size);
+        vector->size = elem_count;
+        *array_inout = vector;
+        result = elem_count;
+    }
+
+    return result;
+}
+
 int32_t _ecs_vector_grow(
     ecs_vector_t **array_inout,
     ecs_size_t elem_size,
@@ -477,3 +503,102 @@ ecs_vector_t* _ecs_vector_copy(
     ecs_os_memcpy(dst, src, offset + elem_size * src->count);
     return dst;
 }
+
+#define SMALL_VECTOR_BUFFER(vector)\
+    ((vector)->size ? (vector)->data.ptr : (vector)->data.inline_data)
+
+void* _ecs_small_vector_add(
+    ecs_small_vector_t *vector,
+    ecs_size_t elem_size)
+{
+    ecs_assert(vector != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(elem_size > 0, ECS_INVALID_PARAMETER, NULL);
+
+    int32_t count = vector->count;
+    int32_t size = vector->size;
+    if (!size) {
+        size = ECS_SMALL_VECTOR_SIZE / elem_size;
+    }
+
+    if (count == size) {
+        /* Elements no longer fit, grow the heap buffer or move the inline
+         * elements to the heap */
+        int32_t new_size = ECS_MAX(size * 2, 2);
+        if (vector->size) {
+            vector->data.ptr = ecs_os_realloc(
+                vector->data.ptr, new_size * elem_size);
+        } else {
+            void *ptr = ecs_os_malloc(new_size * elem_size);
+            ecs_os_memcpy(ptr, vector->data.inline_data, count * elem_size);
+            vector->data.ptr = ptr;
+        }
+        ecs_assert(vector->data.ptr != NULL, ECS_OUT_OF_MEMORY, NULL);
+        vector->size = new_size;
+    }
+
+    vector->count = count + 1;
+
+    return ECS_OFFSET(SMALL_VECTOR_BUFFER(vector), count * elem_size);
+}
+
+void _ecs_small_vector_remove(
+    ecs_small_vector_t *vector,
+    ecs_size_t elem_size,
+    int32_t index)
+{
+    ecs_assert(vector != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(index < vector->count, ECS_INVALID_PARAMETER, NULL);
+
+    void *buffer = SMALL_VECTOR_BUFFER(vector);
+    int32_t count = -- vector->count;
+    if (index != count) {
+        ecs_os_memcpy(ECS_OFFSET(buffer, index * elem_size), 
+            ECS_OFFSET(buffer, count * elem_size), elem_size);
+    }
+}
+
+void* ecs_small_vector_first(
+    const ecs_small_vector_t *vector)
+{
+    if (!vector || !vector->count) {
+        return NULL;
+    }
+
+    return ECS_OFFSET(SMALL_VECTOR_BUFFER(vector), 0);
+}
+
+void* _ecs_small_vector_get(
+    const ecs_small_vector_t *vector,
+    ecs_size_t elem_size,
+    int32_t index)
+{
+    ecs_assert(index >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    if (!vector || index >= vector->count) {
+        return NULL;
+    }
+
+    return ECS_OFFSET(ecs_small_vector_first(vector), index * elem_size);
+}
+
+void ecs_small_vector_free(
+    ecs_small_vector_t *vector)
+{
+    ecs_assert(vector != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    if (vector->size) {
+        ecs_os_free(vector->data.ptr);
+    }
+
+    ecs_os_memset(vector, 0, ECS_SIZEOF(ecs_small_vector_t));
+}
+
+int32_t ecs_small_vector_count(
+    const ecs_small_vector_t *vector)
+{
+    if (!vector) {
+        return 0;
+    }
+
+    return vector->count;
+}
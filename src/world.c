@@ -30,6 +30,9 @@ const ecs_entity_t EcsRemove =  (ECS_HI_COMPONENT_ID + 10);
 const ecs_entity_t EcsDelete =  (ECS_HI_COMPONENT_ID + 11);
 const ecs_entity_t EcsThrow =  (ECS_HI_COMPONENT_ID + 12);
 
+/* Component storage */
+const ecs_entity_t EcsSparse = (ECS_HI_COMPONENT_ID + 13);
+
 /* Builtin relations */
 const ecs_entity_t EcsChildOf = (ECS_HI_COMPONENT_ID + 20);
 const ecs_entity_t EcsIsA = (ECS_HI_COMPONENT_ID + 21) ;
@@ -121,10 +124,72 @@ ecs_stage_t *ecs_stage_from_world(
     return NULL;
 }
 
+/* Find tables that can be affected by a change to monitored entities. A
+ * monitored entity can only be the source of a component for a table if the 
+ * table has a pair with the entity as object, or if the table has a pair with
+ * an entity as object that (recursively) has a pair with the monitored entity. 
+ * Objects of pairs are always watched, so only watched entities need to be
+ * traversed. */
+static
+ecs_vector_t* get_monitored_tables(
+    ecs_world_t *world,
+    ecs_vector_t **entities)
+{
+    ecs_vector_t *result = ecs_vector_new(ecs_table_t*, 0);
+    ecs_map_t *visited = ecs_map_new(ecs_table_t*, 0);
+
+    /* New entities are appended while iterating, don't cache the pointer */
+    int32_t i;
+    for (i = 0; i < ecs_vector_count(*entities); i ++) {
+        ecs_entity_t e = *ecs_vector_get(*entities, ecs_entity_t, i);
+        ecs_id_record_t *idr = ecs_get_id_record(
+            world, ecs_pair(EcsWildcard, e));
+        if (!idr) {
+            continue;
+        }
+
+        ecs_map_iter_t it = ecs_map_iter(idr->table_index);
+        ecs_table_record_t *tr;
+        while ((tr = ecs_map_next(&it, ecs_table_record_t, NULL))) {
+            ecs_table_t *table = tr->table;
+            if (ecs_map_get(visited, ecs_table_t*, table->id)) {
+                continue;
+            }
+
+            ecs_map_set(visited, table->id, &table);
+            ecs_table_t **elem = ecs_vector_add(&result, ecs_table_t*);
+            *elem = table;
+
+            ecs_data_t *data = ecs_table_get_data(table);
+            if (!data) {
+                continue;
+            }
+
+            ecs_entity_t *table_entities = ecs_vector_first(
+                data->entities, ecs_entity_t);
+            ecs_record_t **records = ecs_vector_first(
+                data->record_ptrs, ecs_record_t*);
+            int32_t r, count = ecs_vector_count(data->entities);
+            for (r = 0; r < count; r ++) {
+                if (records[r] && records[r]->row < 0) {
+                    ecs_entity_t *elem_e = ecs_vector_add(
+                        entities, ecs_entity_t);
+                    *elem_e = table_entities[r];
+                }
+            }
+        }
+    }
+
+    ecs_map_free(visited);
+
+    return result;
+}
+
 /* Evaluate component monitor. If a monitored entity changed it will have set a
  * flag in one of the world's component monitors. Queries can register 
  * themselves with component monitors to determine whether they need to rematch
- * with tables. */
+ * with tables. Only tables that can use the changed entities as source are
+ * rematched. */
 static
 void eval_component_monitor(
     ecs_world_t *world)
@@ -135,6 +200,8 @@ void eval_component_monitor(
         return;
     }
 
+    ecs_vector_t *tables = get_monitored_tables(world, &rm->dirty_entities);
+
     ecs_map_iter_t it = ecs_map_iter(rm->monitor_sets);
     ecs_monitor_set_t *ms;
 
@@ -153,7 +220,8 @@ void eval_component_monitor(
 
                 ecs_vector_each(m->queries, ecs_query_t*, q_ptr, {
                     ecs_query_notify(world, *q_ptr, &(ecs_query_event_t) {
-                        .kind = EcsQueryTableRematch
+                        .kind = EcsQueryTableRematch,
+                        .tables = tables
                     });
                 });
 
@@ -164,11 +232,14 @@ void eval_component_monitor(
         ms->is_dirty = false;
     }
 
+    ecs_vector_free(tables);
+    ecs_vector_clear(rm->dirty_entities);
     rm->is_dirty = false;
 }
 
 void ecs_monitor_mark_dirty(
     ecs_world_t *world,
+    ecs_entity_t entity,
     ecs_entity_t relation,
     ecs_entity_t id)
 {
@@ -182,6 +253,10 @@ void ecs_monitor_mark_dirty(
         ecs_monitor_t *m = ecs_map_get(ms->monitors, 
             ecs_monitor_t, id);
         if (m) {
+            ecs_entity_t *elem = ecs_vector_add(
+                &world->monitors.dirty_entities, ecs_entity_t);
+            *elem = entity;
+
             m->is_dirty = true;
             ms->is_dirty = true;
             world->monitors.is_dirty = true;
@@ -243,6 +318,7 @@ void monitors_fini(
     }
 
     ecs_map_free(rm->monitor_sets);
+    ecs_vector_free(rm->dirty_entities);
 }
 
 static
@@ -255,6 +331,19 @@ void init_store(
     world->store.entity_index = ecs_sparse_new(ecs_record_t);
     ecs_sparse_set_id_source(world->store.entity_index, &world->stats.last_id);
 
+#ifdef FLECS_VM_ENTITY_INDEX
+#ifdef FLECS_VM_HUGE_PAGES
+    bool huge_pages = true;
+#else
+    bool huge_pages = false;
+#endif
+    if (!ecs_sparse_reserve_vm(
+        world->store.entity_index, FLECS_VM_ENTITY_COUNT, huge_pages))
+    {
+        ecs_warn("failed to reserve virtual memory for entity index");
+    }
+#endif
+
     /* Initialize root table */
     world->store.tables = ecs_sparse_new(ecs_table_t);
 
@@ -271,6 +360,14 @@ void clean_tables(
 {
     int32_t i, count = ecs_sparse_count(world->store.tables);
 
+    /* Parent records are freed with the id index, so there is no need to keep
+     * child counts up to date while tables are freed */
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *t = ecs_sparse_get(world->store.tables, ecs_table_t, i);
+        ecs_small_vector_free(&t->parents);
+    }
+    ecs_small_vector_free(&world->store.root.parents);
+
     for (i = 0; i < count; i ++) {
         ecs_table_t *t = ecs_sparse_get(world->store.tables, ecs_table_t, i);
         ecs_table_free(world, t);
@@ -291,6 +388,7 @@ void clean_tables(
 
 static
 void fini_store(ecs_world_t *world) {
+    ecs_sparse_storage_fini_all(world);
     clean_tables(world);
     ecs_sparse_free(world->store.tables);
     ecs_table_free(world, &world->store.root);
@@ -345,6 +443,8 @@ ecs_world_t *ecs_mini(void) {
     world->worker_stages = NULL;
     world->workers_waiting = 0;
     world->workers_running = 0;
+    world->level_waiting = 0;
+    world->level_generation = 0;
     world->quit_workers = false;
     world->is_readonly = false;
     world->is_fini = false;
@@ -376,6 +476,8 @@ ecs_world_t *ecs_mini(void) {
     
     world->range_check_enabled = false;
 
+    ecs_set_growth_policy(world, NULL);
+
     world->fps_sleep = 0;
 
     world->context = NULL;
@@ -819,6 +921,17 @@ void fini_stages(
     ecs_set_stages(world, 0);
 }
 
+static
+void free_parent_record(
+    ecs_id_record_t *r)
+{
+    if (r->parent) {
+        ecs_vector_free(r->parent->tables);
+        ecs_os_free(r->parent);
+        r->parent = NULL;
+    }
+}
+
 /* Cleanup id index */
 static
 void fini_id_index(
@@ -828,6 +941,8 @@ void fini_id_index(
     ecs_id_record_t *r;
     while ((r = ecs_map_next(&it, ecs_id_record_t, NULL))) {
         ecs_map_free(r->table_index);
+        ecs_map_free(r->name_index);
+        free_parent_record(r);
     }
 
     ecs_map_free(world->id_index);
@@ -924,6 +1039,8 @@ int ecs_fini(
 
     fini_observers(world);
 
+    ecs_name_index_fini(world);
+
     fini_id_index(world);
 
     fini_id_triggers(world);
@@ -955,6 +1072,80 @@ void ecs_dim(
     ecs_eis_set_size(world, entity_count + ECS_HI_COMPONENT_ID);
 }
 
+void ecs_dim_type(
+    ecs_world_t *world,
+    ecs_type_t type,
+    int32_t entity_count)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);    
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_WHILE_ITERATING, NULL);
+    ecs_assert(entity_count >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    if (type) {
+        ecs_table_t *table = ecs_table_from_type(world, type);
+        ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+        ecs_data_t *data = ecs_table_get_or_create_data(table);
+        ecs_table_reserve(world, table, data, entity_count);
+    }
+}
+
+void ecs_set_growth_policy(
+    ecs_world_t *world,
+    const ecs_growth_policy_t *policy)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+
+    if (policy) {
+        ecs_assert(policy->factor > 1, ECS_INVALID_PARAMETER, NULL);
+        world->growth_policy = *policy;
+    } else {
+        world->growth_policy = (ecs_growth_policy_t){ .factor = 2 };
+    }
+}
+
+void ecs_set_type_growth_policy(
+    ecs_world_t *world,
+    ecs_type_t type,
+    const ecs_growth_policy_t *policy)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(type != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_table_t *table = ecs_table_from_type(world, type);
+    ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (policy) {
+        ecs_assert(policy->factor > 1, ECS_INVALID_PARAMETER, NULL);
+        table->growth_policy = *policy;
+    } else {
+        table->growth_policy = (ecs_growth_policy_t){0};
+    }
+}
+
+int64_t ecs_compact(
+    ecs_world_t *world)
+{
+    ecs_assert(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(world->magic == ECS_WORLD_MAGIC, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!world->is_readonly, ECS_INVALID_WHILE_ITERATING, NULL);
+
+    int64_t freed = 0;
+    int32_t i, count = ecs_sparse_count(world->store.tables);
+    for (i = 0; i < count; i ++) {
+        ecs_table_t *table = ecs_sparse_get(
+            world->store.tables, ecs_table_t, i);
+        freed += ecs_table_compact(world, table);
+    }
+
+    freed += ecs_table_compact(world, &world->store.root);
+    freed += ecs_sparse_compact(world->store.entity_index);
+
+    return freed;
+}
+
 void ecs_eval_component_monitors(
     ecs_world_t *world)
 {
@@ -1372,12 +1563,12 @@ void register_table_for_id(
 
     /* A table can be registered for the same entity multiple times if this is
      * a trait. In that case make sure the column with the first occurrence is
-     * registered with the index */
+     * registered with the index, and count the number of occurrences */
     if (!tr->table || column < tr->column) {
         tr->table = table;
         tr->column = column;
-        tr->count ++;
     }
+    tr->count ++;
 
     /* Set flags if triggers are registered for table */
     if (!(table->flags & EcsTableIsDisabled)) {
@@ -1428,6 +1619,22 @@ void do_register_id(
     }
 }
 
+static
+void register_table_for_parent(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    ecs_id_t id)
+{
+    ecs_id_record_t *r = ecs_get_id_record(world, id);
+    ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    if (!r->parent) {
+        r->parent = ecs_os_calloc(ECS_SIZEOF(ecs_parent_record_t));
+    }
+
+    ecs_table_add_parent(table, r->parent);
+}
+
 static
 void do_register_each_id(
     ecs_world_t *world,
@@ -1454,6 +1661,10 @@ void do_register_each_id(
 
         do_register_id(world, table, id, i, unregister);
 
+        if (!unregister && ECS_HAS_RELATION(id, EcsChildOf)) {
+            register_table_for_parent(world, table, id);
+        }
+
         if (ECS_HAS_ROLE(id, PAIR)) {
             ecs_entity_t pred_w_wildcard = ecs_pair(
                 ECS_PAIR_RELATION(id), EcsWildcard);       
@@ -1483,6 +1694,9 @@ void do_register_each_id(
 
     if (!has_childof) {
         do_register_id(world, table, ecs_pair(EcsChildOf, 0), 0, unregister);
+        if (!unregister) {
+            register_table_for_parent(world, table, ecs_pair(EcsChildOf, 0));
+        }
     }
 }
 
@@ -1497,6 +1711,9 @@ void ecs_unregister_table(
     ecs_world_t *world,
     ecs_table_t *table)
 {
+    /* Remove table from the children of its parents */
+    ecs_table_clear_parents(table);
+
     /* Remove table from id indices */
     do_register_each_id(world, table, true);
 
@@ -1524,7 +1741,7 @@ ecs_id_record_t* ecs_get_id_record(
 }
 
 void ecs_clear_id_record(
-    const ecs_world_t *world,
+    ecs_world_t *world,
     ecs_id_t id)    
 {
     ecs_id_record_t *r = ecs_get_id_record(world, id);
@@ -1532,6 +1749,9 @@ void ecs_clear_id_record(
         return;
     }
 
+    ecs_sparse_storage_fini(world, id, r);
     ecs_map_free(r->table_index);
+    ecs_map_free(r->name_index);
+    free_parent_record(r);
     ecs_map_remove(world->id_index, id);
 }
@@ -2458,3 +2458,63 @@ void ComponentLifecycle_delete_self_in_dtor_on_delete() {
 
     ecs_fini(world);
 }
+
+static ecs_entity_t copy_entities[8];
+static int32_t copy_entity_count = 0;
+
+static
+void copy_record_entity(
+    ecs_world_t *world,
+    ecs_entity_t component,
+    const ecs_entity_t *dst_entity,
+    const ecs_entity_t *src_entity,
+    void *dst_ptr,
+    const void *src_ptr,
+    size_t size,
+    int32_t count,
+    void *ctx)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        test_assert(copy_entity_count < 8);
+        copy_entities[copy_entity_count ++] = dst_entity[i];
+    }
+
+    ecs_os_memcpy(dst_ptr, src_ptr, ecs_from_size_t(size) * count);
+}
+
+void ComponentLifecycle_copy_on_bulk_override() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_component_actions(world, Position, {
+        .copy = copy_record_entity
+    });
+
+    ecs_entity_t base = ecs_new_w_id(world, EcsPrefab);
+    ecs_set(world, base, Position, {10, 20});
+    copy_entity_count = 0;
+
+    ecs_id_t ids[] = { ecs_pair(EcsIsA, base), ecs_id(Position) };
+    const ecs_entity_t *e = ecs_bulk_new_w_data(world, 4, 
+        &(ecs_ids_t){ .array = ids, .count = 2 }, NULL);
+    test_assert(e != NULL);
+
+    ecs_entity_t entities[4];
+    ecs_os_memcpy(entities, e, 4 * ECS_SIZEOF(ecs_entity_t));
+
+    test_int(copy_entity_count, 4);
+
+    int32_t i;
+    for (i = 0; i < 4; i ++) {
+        test_int(copy_entities[i], entities[i]);
+
+        const Position *p = ecs_get(world, entities[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+    }
+
+    ecs_fini(world);
+}
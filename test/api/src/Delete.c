@@ -690,3 +690,186 @@ void Delete_move_w_no_dtor_move() {
 
     ecs_fini(world);
 }
+
+void Delete_delete_n() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e[5];
+    int i;
+    for (i = 0; i < 5; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    ecs_entity_t to_delete[3] = {e[3], e[0], e[1]};
+    ecs_delete_n(world, to_delete, 3);
+
+    test_assert(!ecs_is_alive(world, e[0]));
+    test_assert(!ecs_is_alive(world, e[1]));
+    test_assert(ecs_is_alive(world, e[2]));
+    test_assert(!ecs_is_alive(world, e[3]));
+    test_assert(ecs_is_alive(world, e[4]));
+
+    test_int(ecs_count(world, Position), 2);
+
+    const Position *p = ecs_get(world, e[2], Position);
+    test_assert(p != NULL);
+    test_int(p->x, 2);
+    test_int(p->y, 4);
+
+    p = ecs_get(world, e[4], Position);
+    test_assert(p != NULL);
+    test_int(p->x, 4);
+    test_int(p->y, 8);
+
+    ecs_fini(world);
+}
+
+void Delete_delete_n_multiple_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e4 = ecs_set(world, 0, Velocity, {3, 4});
+    ecs_entity_t e5 = ecs_new(world, 0);
+
+    ecs_entity_t to_delete[4] = {e4, e1, e5, e2};
+    ecs_delete_n(world, to_delete, 4);
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(!ecs_is_alive(world, e2));
+    test_assert(ecs_is_alive(world, e3));
+    test_assert(!ecs_is_alive(world, e4));
+    test_assert(!ecs_is_alive(world, e5));
+
+    test_int(ecs_count(world, Position), 1);
+    test_int(ecs_count(world, Velocity), 0);
+
+    const Position *p = ecs_get(world, e3, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+static Probe delete_n_probe;
+
+static
+void OnRemovePosition(ecs_iter_t *it) {
+    probe_system_w_ctx(it, &delete_n_probe);
+}
+
+void Delete_delete_n_w_on_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TRIGGER(world, OnRemovePosition, EcsOnRemove, Position);
+
+    ecs_entity_t e[5];
+    int i;
+    for (i = 0; i < 5; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    /* Rows 0, 1 and 3 are removed, which are two ranges */
+    ecs_os_memset(&delete_n_probe, 0, ECS_SIZEOF(Probe));
+    ecs_entity_t to_delete[3] = {e[3], e[0], e[1]};
+    ecs_delete_n(world, to_delete, 3);
+
+    test_int(delete_n_probe.invoked, 2);
+    test_int(delete_n_probe.count, 3);
+    probe_has_entity(&delete_n_probe, e[0]);
+    probe_has_entity(&delete_n_probe, e[1]);
+    probe_has_entity(&delete_n_probe, e[3]);
+
+    ecs_fini(world);
+}
+
+void Delete_delete_n_w_dtor() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, ecs_id(Position), EcsComponentLifecycle, {
+        .dtor = ecs_dtor(Position),
+        .move = ecs_move(Position),
+    });
+
+    ecs_entity_t e[5];
+    int i;
+    for (i = 0; i < 5; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    dtor_invoked = 0;
+    move_invoked = 0;
+
+    /* Row 1 is filled with the last entity, row 3 is destructed */
+    ecs_entity_t to_delete[2] = {e[1], e[3]};
+    ecs_delete_n(world, to_delete, 2);
+
+    test_int(move_invoked, 1);
+    test_int(move_dst_x, 1);
+    test_int(move_src_x, 4);
+    test_int(dtor_invoked, 2);
+
+    test_int(ecs_count(world, Position), 3);
+
+    int alive[3] = {0, 2, 4};
+    for (i = 0; i < 3; i ++) {
+        const Position *p = ecs_get(world, e[alive[i]], Position);
+        test_assert(p != NULL);
+        test_int(p->x, alive[i]);
+        test_int(p->y, alive[i] * 2);
+    }
+
+    ecs_fini(world);
+}
+
+void Delete_delete_n_w_duplicate() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_entity_t to_delete[3] = {e1, e1, e1};
+    ecs_delete_n(world, to_delete, 3);
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+    test_int(ecs_count(world, Position), 1);
+
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void Delete_delete_n_not_alive() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_delete(world, e1);
+
+    ecs_entity_t to_delete[2] = {e1, e2};
+    ecs_delete_n(world, to_delete, 2);
+
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(!ecs_is_alive(world, e2));
+    test_int(ecs_count(world, Position), 0);
+
+    ecs_fini(world);
+}
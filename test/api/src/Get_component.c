@@ -213,3 +213,100 @@ void Get_component_get_childof_component() {
     test_expect_abort();
     ecs_get(world, ECS_CHILDOF | ecs_typeid(Position), EcsComponent);
 }
+
+void Get_component_get_many() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t entities[3];
+    entities[0] = ecs_set(world, 0, Position, {10, 20});
+    entities[1] = ecs_set(world, 0, Position, {30, 40});
+    entities[2] = ecs_set(world, 0, Position, {50, 60});
+
+    const Position *ptrs[3];
+    ecs_get_many(world, entities, 3, Position, ptrs);
+
+    test_assert(ptrs[0] == ecs_get(world, entities[0], Position));
+    test_assert(ptrs[1] == ecs_get(world, entities[1], Position));
+    test_assert(ptrs[2] == ecs_get(world, entities[2], Position));
+
+    test_int(ptrs[0]->x, 10);
+    test_int(ptrs[0]->y, 20);
+    test_int(ptrs[1]->x, 30);
+    test_int(ptrs[1]->y, 40);
+    test_int(ptrs[2]->x, 50);
+    test_int(ptrs[2]->y, 60);
+
+    ecs_fini(world);
+}
+
+void Get_component_get_many_w_missing() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t entities[3];
+    entities[0] = ecs_set(world, 0, Position, {10, 20});
+    entities[1] = ecs_set(world, 0, Velocity, {1, 2});
+    entities[2] = ecs_new(world, 0);
+
+    const Position *ptrs[3];
+    ecs_get_many(world, entities, 3, Position, ptrs);
+
+    test_assert(ptrs[0] != NULL);
+    test_int(ptrs[0]->x, 10);
+    test_int(ptrs[0]->y, 20);
+    test_assert(ptrs[1] == NULL);
+    test_assert(ptrs[2] == NULL);
+
+    ecs_fini(world);
+}
+
+void Get_component_get_many_from_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_entity_t entities[2];
+    entities[0] = ecs_new_w_pair(world, EcsIsA, base);
+    entities[1] = ecs_set(world, 0, Position, {30, 40});
+
+    const Position *ptrs[2];
+    ecs_get_many(world, entities, 2, Position, ptrs);
+
+    test_assert(ptrs[0] == ecs_get(world, base, Position));
+    test_assert(ptrs[1] == ecs_get(world, entities[1], Position));
+
+    ecs_fini(world);
+}
+
+void Get_component_get_many_mixed_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t entities[4];
+    entities[0] = ecs_set(world, 0, Position, {10, 20});
+    entities[1] = ecs_set(world, 0, Position, {30, 40});
+    ecs_set(world, entities[1], Velocity, {1, 2});
+    entities[2] = ecs_set(world, 0, Position, {50, 60});
+    entities[3] = ecs_set(world, 0, Position, {70, 80});
+    ecs_set(world, entities[3], Velocity, {3, 4});
+
+    const Position *ptrs[4];
+    ecs_get_many(world, entities, 4, Position, ptrs);
+
+    int i;
+    for (i = 0; i < 4; i ++) {
+        test_assert(ptrs[i] == ecs_get(world, entities[i], Position));
+        test_int(ptrs[i]->x, 10 + i * 20);
+        test_int(ptrs[i]->y, 20 + i * 20);
+    }
+
+    ecs_fini(world);
+}
@@ -1692,3 +1692,238 @@ void Hierarchies_long_name_depth_2() {
 
     ecs_fini(world);
 }
+
+void Hierarchies_get_child_count_after_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child_1 = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_entity_t child_2 = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child_2, Position);
+    test_int(ecs_get_child_count(world, parent), 2);
+
+    ecs_remove_pair(world, child_1, EcsChildOf, parent);
+    test_int(ecs_get_child_count(world, parent), 1);
+
+    ecs_delete(world, child_2);
+    test_int(ecs_get_child_count(world, parent), 0);
+
+    ecs_add_pair(world, child_1, EcsChildOf, parent);
+    test_int(ecs_get_child_count(world, parent), 1);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_get_child_count_after_reparent() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t parent_1 = ecs_new(world, 0);
+    ecs_entity_t parent_2 = ecs_new(world, 0);
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent_1);
+    test_int(ecs_get_child_count(world, parent_1), 1);
+    test_int(ecs_get_child_count(world, parent_2), 0);
+
+    ecs_remove_pair(world, child, EcsChildOf, parent_1);
+    ecs_add_pair(world, child, EcsChildOf, parent_2);
+    test_int(ecs_get_child_count(world, parent_1), 0);
+    test_int(ecs_get_child_count(world, parent_2), 1);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_get_child_count_bulk() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    const ecs_entity_t *ids = ecs_bulk_new_w_id(
+        world, ecs_pair(EcsChildOf, parent), 100);
+    test_assert(ids != NULL);
+    test_int(ecs_get_child_count(world, parent), 100);
+
+    ecs_delete_children(world, parent);
+    test_int(ecs_get_child_count(world, parent), 0);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_get_child_count_after_delete_parent() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_new_w_pair(world, EcsChildOf, child);
+    test_int(ecs_get_child_count(world, parent), 1);
+    test_int(ecs_get_child_count(world, child), 1);
+
+    ecs_delete(world, parent);
+    test_int(ecs_get_child_count(world, parent), 0);
+    test_int(ecs_get_child_count(world, child), 0);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_scope_iter_skip_empty_tables() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child_1 = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child_1, Position);
+    ecs_entity_t child_2 = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child_2, Velocity);
+
+    /* Empty the table with Position */
+    ecs_remove(world, child_1, Position);
+    ecs_add(world, child_1, Velocity);
+
+    ecs_iter_t it = ecs_scope_iter(world, parent);
+    test_int(it.table_count, 1);
+    test_assert(ecs_scope_next(&it));
+    test_int(it.count, 2);
+    test_assert(!ecs_scope_next(&it));
+
+    ecs_fini(world);
+}
+
+void Hierarchies_scope_iter_delete_while_iterating() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_COMPONENT(world, Mass);
+
+    ecs_entity_t parent = ecs_new(world, 0);
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child, Position);
+    child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child, Velocity);
+    child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child, Mass);
+    test_int(ecs_get_child_count(world, parent), 3);
+
+    int32_t table_count = 0;
+    ecs_iter_t it = ecs_scope_iter(world, parent);
+    while (ecs_scope_next(&it)) {
+        test_int(it.count, 1);
+        ecs_delete(world, it.entities[0]);
+        table_count ++;
+    }
+
+    test_int(table_count, 3);
+    test_int(ecs_get_child_count(world, parent), 0);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_delete_tree_w_dtor_many_children() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_component_actions(world, Position, {
+        .dtor = ecs_dtor(Position)
+    });
+
+    dtor_count = 0;
+
+    ecs_entity_t parent = ecs_new(world, Position);
+    ecs_entity_t children[100];
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        children[i] = ecs_new_w_pair(world, EcsChildOf, parent);
+        ecs_add(world, children[i], Position);
+
+        ecs_entity_t grandchild = ecs_new_w_pair(world, EcsChildOf, children[i]);
+        ecs_add(world, grandchild, Position);
+    }
+
+    ecs_delete(world, parent);
+
+    test_assert( !ecs_is_alive(world, parent));
+    for (i = 0; i < 100; i ++) {
+        test_assert( !ecs_is_alive(world, children[i]));
+    }
+
+    test_int(dtor_count, 201);
+
+    ecs_fini(world);
+}
+
+void Hierarchies_delete_deep_tree() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t root = ecs_new(world, 0);
+    ecs_entity_t parent = root;
+    ecs_entity_t children[1000];
+
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        children[i] = ecs_new_w_pair(world, EcsChildOf, parent);
+        ecs_add(world, children[i], Position);
+        parent = children[i];
+    }
+
+    ecs_delete(world, root);
+
+    test_assert( !ecs_is_alive(world, root));
+    for (i = 0; i < 1000; i ++) {
+        test_assert( !ecs_is_alive(world, children[i]));
+    }
+
+    test_int(ecs_count(world, Position), 0);
+
+    ecs_fini(world);
+}
+
+static ecs_entity_t removed[3];
+static int removed_count = 0;
+
+static
+void RemovePositionOrder(ecs_iter_t *it) {
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_entity_t e = it->entities[i];
+
+        /* Parent is still alive while its children are removed */
+        ecs_entity_t parent = ecs_get_object_w_id(it->world, e, EcsChildOf, 0);
+        test_assert(!parent || ecs_is_alive(it->world, parent));
+
+        test_assert(removed_count < 3);
+        removed[removed_count ++] = e;
+    }
+}
+
+void Hierarchies_delete_tree_onremove_order() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_TRIGGER(world, RemovePositionOrder, EcsOnRemove, Position);
+
+    ecs_entity_t parent = ecs_new(world, Position);
+    ecs_entity_t child = ecs_new_w_pair(world, EcsChildOf, parent);
+    ecs_add(world, child, Position);
+    ecs_entity_t grandchild = ecs_new_w_pair(world, EcsChildOf, child);
+    ecs_add(world, grandchild, Position);
+
+    ecs_delete(world, parent);
+
+    test_assert( !ecs_is_alive(world, parent));
+    test_assert( !ecs_is_alive(world, child));
+    test_assert( !ecs_is_alive(world, grandchild));
+
+    /* Hierarchy is deleted bottom up */
+    test_int(removed_count, 3);
+    test_assert(removed[0] == grandchild);
+    test_assert(removed[1] == child);
+    test_assert(removed[2] == parent);
+
+    ecs_fini(world);
+}
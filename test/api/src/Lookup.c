@@ -340,3 +340,216 @@ void Lookup_lookup_path_wildcard_from_scope() {
 
     ecs_fini(world);
 }
+
+void Lookup_lookup_after_rename() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"foo"});
+    test_assert(ecs_lookup(world, "foo") == e);
+
+    ecs_set(world, e, EcsName, {"bar"});
+    test_assert(ecs_lookup(world, "foo") == 0);
+    test_assert(ecs_lookup(world, "bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_reparent() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent1, 0);
+    ECS_ENTITY(world, Parent2, 0);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Child"});
+    ecs_add_pair(world, e, EcsChildOf, Parent1);
+    test_assert(ecs_lookup_fullpath(world, "Parent1.Child") == e);
+    test_assert(ecs_lookup_fullpath(world, "Parent2.Child") == 0);
+
+    ecs_remove_pair(world, e, EcsChildOf, Parent1);
+    ecs_add_pair(world, e, EcsChildOf, Parent2);
+    test_assert(ecs_lookup_fullpath(world, "Parent1.Child") == 0);
+    test_assert(ecs_lookup_fullpath(world, "Parent2.Child") == e);
+
+    ecs_remove_pair(world, e, EcsChildOf, Parent2);
+    test_assert(ecs_lookup_fullpath(world, "Parent2.Child") == 0);
+    test_assert(ecs_lookup(world, "Child") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_delete() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"foo"});
+    test_assert(ecs_lookup(world, "foo") == e);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup(world, "foo") == 0);
+
+    ecs_entity_t e2 = ecs_set(world, 0, EcsName, {"foo"});
+    test_assert(e2 != e);
+    test_assert(ecs_lookup(world, "foo") == e2);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_add_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"foo"});
+    test_assert(ecs_lookup(world, "foo") == e);
+
+    ecs_add(world, e, Position);
+    test_assert(ecs_lookup(world, "foo") == e);
+
+    ecs_remove(world, e, EcsName);
+    test_assert(ecs_lookup(world, "foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_symbol_after_set_symbol() {
+    ecs_world_t *world = ecs_init();
+
+    test_assert(ecs_lookup_symbol(world, "my_symbol") == 0);
+
+    ecs_entity_t e = ecs_entity_init(world, &(ecs_entity_desc_t){
+        .name = "MyEntity",
+        .symbol = "my_symbol"
+    });
+    test_assert(e != 0);
+    test_assert(ecs_lookup_symbol(world, "my_symbol") == e);
+
+    ecs_delete(world, e);
+    test_assert(ecs_lookup_symbol(world, "my_symbol") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_many_children() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_ENTITY(world, Parent, 0);
+
+    ecs_entity_t children[1000];
+    char name[32];
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_os_sprintf(name, "Child%d", i);
+        children[i] = ecs_entity_init(world, &(ecs_entity_desc_t){
+            .name = name,
+            .add = {ecs_pair(EcsChildOf, Parent)}
+        });
+        test_assert(children[i] != 0);
+    }
+
+    for (i = 0; i < 1000; i ++) {
+        ecs_os_sprintf(name, "Child%d", i);
+        test_assert(ecs_lookup_child(world, Parent, name) == children[i]);
+    }
+
+    test_assert(ecs_lookup_child(world, Parent, "Child1000") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_many_renames() {
+    ecs_world_t *world = ecs_init();
+
+    static char foo[5000][16];
+    static char bar[5000][16];
+    ecs_entity_t entities[5000];
+    int i;
+    for (i = 0; i < 5000; i ++) {
+        ecs_os_sprintf(foo[i], "foo%d", i);
+        ecs_os_sprintf(bar[i], "bar%d", i);
+        entities[i] = ecs_set(world, 0, EcsName, {foo[i]});
+    }
+
+    test_assert(ecs_lookup(world, "foo0") == entities[0]);
+
+    /* More renames than can be tracked between two lookups */
+    for (i = 0; i < 5000; i ++) {
+        ecs_set(world, entities[i], EcsName, {bar[i]});
+    }
+
+    for (i = 0; i < 5000; i ++) {
+        test_assert(ecs_lookup(world, foo[i]) == 0);
+        test_assert(ecs_lookup(world, bar[i]) == entities[i]);
+    }
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_emplace_name() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_new_id(world);
+
+    /* Make sure the name index is used */
+    test_assert(ecs_lookup(world, "Bar") == 0);
+
+    EcsName *name = ecs_emplace(world, e, EcsName);
+    test_assert(name != NULL);
+    *name = (EcsName){ .value = "Bar" };
+    ecs_modified(world, e, EcsName);
+
+    test_assert(ecs_lookup(world, "Bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_modified_name() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    /* Change the name in place through a pointer obtained earlier */
+    EcsName *name = ecs_get_mut(world, e, EcsName, NULL);
+    test_assert(ecs_lookup(world, "Foo") == e);
+    name->value = "Bar";
+    ecs_modified(world, e, EcsName);
+
+    test_assert(ecs_lookup(world, "Foo") == 0);
+    test_assert(ecs_lookup(world, "Bar") == e);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_after_get_mut_name() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo"});
+    test_assert(ecs_lookup(world, "Foo") == e);
+
+    /* Change the name in place without calling ecs_modified */
+    EcsName *name = ecs_get_mut(world, e, EcsName, NULL);
+    test_assert(ecs_lookup(world, "Foo") == e);
+    name->value = "Bar";
+
+    test_assert(ecs_lookup(world, "Bar") == e);
+    test_assert(ecs_lookup(world, "Foo") == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_lookup_symbol_after_get_mut_symbol() {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t e = ecs_set(world, 0, EcsName, {"Foo", "foo_t"});
+    test_assert(ecs_lookup_symbol(world, "foo_t") == e);
+
+    /* Change the symbol in place without calling ecs_modified */
+    EcsName *name = ecs_get_mut(world, e, EcsName, NULL);
+    test_assert(ecs_lookup_symbol(world, "foo_t") == e);
+    ecs_os_free(name->symbol);
+    name->symbol = ecs_os_strdup("bar_t");
+
+    test_assert(ecs_lookup_symbol(world, "bar_t") == e);
+    test_assert(ecs_lookup_symbol(world, "foo_t") == 0);
+
+    ecs_fini(world);
+}
@@ -884,3 +884,67 @@ void MultiThread_fini_after_set_threads() {
     // Make sure code doesn't crash
     test_assert(true);
 }
+
+static
+void PropagateDepth(ecs_iter_t *it) {
+    Position *p = ecs_term(it, Position, 1);
+    Position *parent = ecs_term(it, Position, 2);
+
+    if (!parent) {
+        return;
+    }
+
+    float x = parent->x + 1;
+
+    /* Give workers iterating tables of the next level the opportunity to read
+     * the value before it is written, if levels are not synchronized */
+    ecs_os_sleep(0, 1000 * 1000);
+
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        p[i].x = x;
+    }
+}
+
+void MultiThread_cascade_level_barrier() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+    ECS_TAG(world, TagC);
+
+    ECS_SYSTEM(world, PropagateDepth, EcsOnUpdate, Position, CASCADE:Position);
+
+    ecs_entity_t tags[] = {TagA, TagB, TagC};
+
+    int i, j, DEPTH = 6, CHILDREN = 8;
+    ecs_entity_t parents[8] = {0};
+    ecs_entity_t children[8];
+    ecs_entity_t leafs[8];
+
+    parents[0] = ecs_set(world, 0, Position, {0, 0});
+    for (i = 1; i < CHILDREN; i ++) {
+        parents[i] = parents[0];
+    }
+
+    for (i = 0; i < DEPTH; i ++) {
+        for (j = 0; j < CHILDREN; j ++) {
+            children[j] = ecs_set(world, 0, Position, {-1, 0});
+            ecs_add_id(world, children[j], tags[j % 3]);
+            ecs_add_pair(world, children[j], EcsChildOf, parents[j]);
+        }
+        ecs_os_memcpy(parents, children, sizeof(children));
+    }
+    ecs_os_memcpy(leafs, children, sizeof(children));
+
+    ecs_set_threads(world, 4);
+
+    ecs_progress(world, 0);
+
+    for (j = 0; j < CHILDREN; j ++) {
+        test_int(ecs_get(world, leafs[j], Position)->x, DEPTH);
+    }
+
+    ecs_fini(world);
+}
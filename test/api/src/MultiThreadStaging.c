@@ -465,3 +465,96 @@ void MultiThreadStaging_custom_thread_partial_manual_merge() {
 
     ecs_fini(world);
 }
+
+void MultiThreadStaging_new_id_from_stages_unique() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_stages(world, 2);
+
+    ecs_world_t *ctx_1 = ecs_get_stage(world, 0);
+    ecs_world_t *ctx_2 = ecs_get_stage(world, 1);
+
+    ecs_entity_t ids[12];
+    int32_t i, j, count = 0;
+
+    /* Second frame uses ids reserved for the stages during the first merge */
+    for (i = 0; i < 2; i ++) {
+        ecs_frame_begin(world, 0);
+        ecs_staging_begin(world);
+
+        for (j = 0; j < 3; j ++) {
+            ids[count] = ecs_set(ctx_1, 0, Position, {count, 0});
+            count ++;
+            ids[count] = ecs_set(ctx_2, 0, Position, {count, 0});
+            count ++;
+        }
+
+        ecs_staging_end(world);
+        ecs_frame_end(world);
+    }
+
+    test_int(count, 12);
+
+    for (i = 0; i < count; i ++) {
+        test_assert(ids[i] != 0);
+        test_assert(ecs_is_alive(world, ids[i]));
+        test_assert(ecs_has(world, ids[i], Position));
+
+        const Position *p = ecs_get(world, ids[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+
+        for (j = i + 1; j < count; j ++) {
+            test_assert(ids[i] != ids[j]);
+        }
+    }
+
+    ecs_fini(world);
+}
+
+void MultiThreadStaging_new_id_from_stage_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new(world, 0);
+    test_assert(e != 0);
+    ecs_delete(world, e);
+
+    ecs_set_stages(world, 2);
+
+    ecs_world_t *ctx_1 = ecs_get_stage(world, 0);
+
+    /* First frame creates an id without a reserved block */
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    ecs_entity_t e1 = ecs_set(ctx_1, 0, Position, {10, 20});
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    test_assert(e1 != 0);
+    test_assert((uint32_t)e1 != (uint32_t)e);
+
+    /* Second frame should get the deleted id, which was reserved for the stage
+     * when it was merged */
+    ecs_frame_begin(world, 0);
+    ecs_staging_begin(world);
+    ecs_entity_t e2 = ecs_set(ctx_1, 0, Position, {30, 40});
+    ecs_staging_end(world);
+    ecs_frame_end(world);
+
+    test_assert(e2 != 0);
+    test_assert(e2 != e);
+    test_assert((uint32_t)e2 == (uint32_t)e);
+    test_assert(!ecs_is_alive(world, e));
+    test_assert(ecs_is_alive(world, e2));
+
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
@@ -160,13 +160,13 @@ void Pairs_type_w_two_pairs() {
     ecs_entity_t hi = ECS_PAIR_RELATION(c);
     ecs_entity_t lo = ECS_PAIR_OBJECT(c);
     test_int(hi, ecs_typeid(Rel));
-    test_int(lo, ecs_typeid(Velocity));
+    test_int(lo, ecs_typeid(Position));
 
     c = ctx.c[1][0];
     hi = ECS_PAIR_RELATION(c);
     lo = ECS_PAIR_OBJECT(c);
     test_int(hi, ecs_typeid(Rel));
-    test_int(lo, ecs_typeid(Position));
+    test_int(lo, ecs_typeid(Velocity));
 
     test_int(ctx.s[0][0], 0);
     test_int(ctx.s[1][0], 0);
@@ -2167,3 +2167,67 @@ void Pairs_tag_pair_w_isa_w_comp() {
 
     ecs_fini(world);
 }
+
+void Pairs_get_object_for_rel() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Rel);
+    ECS_TAG(world, Rel_2);
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t obj_1 = ecs_new_id(world);
+    ecs_entity_t obj_2 = ecs_new_id(world);
+
+    ecs_entity_t e = ecs_new(world, Tag);
+    test_int(ecs_get_object_w_id(world, e, Rel, 0), 0);
+
+    ecs_add_pair(world, e, Rel_2, obj_1);
+    test_int(ecs_get_object_w_id(world, e, Rel, 0), 0);
+    test_int(ecs_get_object_w_id(world, e, Rel_2, 0), obj_1);
+
+    ecs_add_pair(world, e, Rel, obj_2);
+    ecs_add_pair(world, e, Rel, obj_1);
+    test_int(ecs_get_object_w_id(world, e, Rel, 0), obj_1);
+    test_int(ecs_get_object_w_id(world, e, Rel_2, 0), obj_1);
+
+    ecs_remove_pair(world, e, Rel, obj_1);
+    test_int(ecs_get_object_w_id(world, e, Rel, 0), obj_2);
+
+    ecs_fini(world);
+}
+
+void Pairs_query_2_pairs_w_pred_wildcard() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Rel);
+    ECS_TAG(world, Rel_2);
+    ECS_TAG(world, Obj);
+    ECS_TAG(world, Obj_2);
+
+    ecs_query_t *q = ecs_query_init(world, &(ecs_query_desc_t){
+        .filter.expr = "(*, Obj)"
+    });
+
+    test_assert(q != NULL);
+
+    ecs_entity_t e1 = ecs_entity_init(world, &(ecs_entity_desc_t){
+        .add = {ecs_pair(Rel, Obj), ecs_pair(Rel_2, Obj_2), 
+            ecs_pair(Rel_2, Obj)} });
+    test_assert(e1 != 0);
+
+    ecs_iter_t it = ecs_query_iter(q);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    test_int(ecs_term_id(&it, 1), ecs_pair(Rel, Obj));
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    test_int(ecs_term_id(&it, 1), ecs_pair(Rel_2, Obj));
+
+    test_bool(ecs_query_next(&it), false); 
+
+    ecs_fini(world);
+}
@@ -3265,3 +3265,339 @@ void Prefab_rematch_after_add_to_recycled_base() {
 
     ecs_fini(world);
 }
+
+void Prefab_rematch_after_add_to_nested_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "SHARED:Position");
+
+    ecs_entity_t base_1 = ecs_new_w_id(world, EcsPrefab);
+    ecs_entity_t base_2 = ecs_new_w_id(world, EcsPrefab);
+    ecs_add_pair(world, base_2, EcsIsA, base_1);
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base_2);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_set(world, base_1, Position, {10, 20});
+
+    ecs_progress(world, 0);
+
+    it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e);
+
+    const Position *p = ecs_term(&it, Position, 1);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    test_assert(ecs_term_source(&it, 1) == base_1);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void Prefab_rematch_after_add_to_2_bases() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "SHARED:Position");
+
+    ecs_entity_t base_1 = ecs_new_w_id(world, EcsPrefab);
+    ecs_entity_t base_2 = ecs_new_w_id(world, EcsPrefab);
+    ecs_entity_t e_1 = ecs_new_w_pair(world, EcsIsA, base_1);
+    ecs_entity_t e_2 = ecs_new_w_pair(world, EcsIsA, base_2);
+
+    ecs_set(world, base_1, Position, {10, 20});
+    ecs_progress(world, 0);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e_1);
+    test_assert(ecs_term_source(&it, 1) == base_1);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_set(world, base_2, Position, {30, 40});
+    ecs_progress(world, 0);
+
+    int32_t count = 0;
+    it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        test_int(it.count, 1);
+        const Position *p = ecs_term(&it, Position, 1);
+        if (it.entities[0] == e_1) {
+            test_assert(ecs_term_source(&it, 1) == base_1);
+            test_int(p->x, 10);
+        } else {
+            test_int(it.entities[0], e_2);
+            test_assert(ecs_term_source(&it, 1) == base_2);
+            test_int(p->x, 30);
+        }
+        count ++;
+    }
+
+    test_int(count, 2);
+
+    ecs_remove(world, base_1, Position);
+    ecs_progress(world, 0);
+
+    it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e_2);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void Prefab_bulk_instantiate_w_children() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t base = ecs_new_w_id(world, EcsPrefab);
+    ecs_entity_t child_1 = ecs_new_w_id(world, EcsPrefab);
+    ecs_add_pair(world, child_1, EcsChildOf, base);
+    ecs_set(world, child_1, Position, {10, 20});
+
+    ecs_entity_t child_2 = ecs_new_w_id(world, EcsPrefab);
+    ecs_add_pair(world, child_2, EcsChildOf, base);
+    ecs_set(world, child_2, Position, {30, 40});
+
+    ecs_entity_t grand_child = ecs_new_w_id(world, EcsPrefab);
+    ecs_add_pair(world, grand_child, EcsChildOf, child_2);
+    ecs_set(world, grand_child, Velocity, {1, 2});
+
+    const ecs_entity_t *ids = ecs_bulk_new_w_id(
+        world, ecs_pair(EcsIsA, base), 3);
+    test_assert(ids != NULL);
+
+    ecs_entity_t instances[3];
+    ecs_os_memcpy(instances, ids, 3 * ECS_SIZEOF(ecs_entity_t));
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_entity_t inst = instances[i];
+        test_assert(ecs_has_pair(world, inst, EcsIsA, base));
+
+        ecs_iter_t it = ecs_scope_iter(world, inst);
+
+        int32_t count = 0, nested = 0;
+        while (ecs_scope_next(&it)) {
+            int32_t j;
+            for (j = 0; j < it.count; j ++) {
+                ecs_entity_t child = it.entities[j];
+                test_assert(!ecs_has_id(world, child, EcsPrefab));
+
+                const Position *p = ecs_get(world, child, Position);
+                test_assert(p != NULL);
+
+                if (p->x == 30) {
+                    test_int(p->y, 40);
+
+                    ecs_iter_t cit = ecs_scope_iter(world, child);
+                    while (ecs_scope_next(&cit)) {
+                        int32_t k;
+                        for (k = 0; k < cit.count; k ++) {
+                            const Velocity *v = ecs_get(
+                                world, cit.entities[k], Velocity);
+                            test_assert(v != NULL);
+                            test_int(v->x, 1);
+                            test_int(v->y, 2);
+                            nested ++;
+                        }
+                    }
+                } else {
+                    test_int(p->x, 10);
+                    test_int(p->y, 20);
+                }
+
+                count ++;
+            }
+        }
+
+        test_int(count, 2);
+        test_int(nested, 1);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_get_from_base_after_override_in_nested_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base_1 = ecs_new_w_id(world, EcsPrefab);
+    ecs_set(world, base_1, Position, {10, 20});
+
+    ecs_entity_t base_2 = ecs_new_w_id(world, EcsPrefab);
+    ecs_add_pair(world, base_2, EcsIsA, base_1);
+
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base_2);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_get(world, base_1, Position));
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    /* Get again, should be resolved from cache */
+    test_assert(p == ecs_get(world, e, Position));
+
+    ecs_set(world, base_2, Position, {30, 40});
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_get(world, base_2, Position));
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_remove(world, base_2, Position);
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_get(world, base_1, Position));
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_remove(world, base_1, Position);
+    test_assert(ecs_get(world, e, Position) == NULL);
+
+    ecs_fini(world);
+}
+
+void Prefab_get_from_base_after_base_moved() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t base = ecs_new_w_id(world, EcsPrefab);
+    ecs_set(world, base, Position, {10, 20});
+
+    ecs_entity_t e = ecs_new_w_pair(world, EcsIsA, base);
+    test_assert(ecs_get(world, e, Velocity) == NULL);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    /* Adding a component to the base moves it to another table */
+    ecs_set(world, base, Velocity, {1, 2});
+
+    p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_get(world, base, Position));
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_fini(world);
+}
+
+void Prefab_bulk_new_w_override() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_PREFAB(world, Prefab, Position, Velocity);
+    ECS_TYPE(world, Type, INSTANCEOF | Prefab, Position);
+
+    ecs_set(world, Prefab, Position, {10, 20});
+    ecs_set(world, Prefab, Velocity, {30, 40});
+
+    const ecs_entity_t *ids = ecs_bulk_new(world, Type, 11);
+    test_assert(ids != NULL);
+
+    ecs_entity_t entities[11];
+    ecs_os_memcpy(entities, ids, 11 * ECS_SIZEOF(ecs_entity_t));
+
+    const Position *p_prefab = ecs_get(world, Prefab, Position);
+    const Velocity *v_prefab = ecs_get(world, Prefab, Velocity);
+
+    int i;
+    for (i = 0; i < 11; i ++) {
+        ecs_entity_t e = entities[i];
+        test_assert(ecs_owns(world, e, Position, true));
+        test_assert(!ecs_owns(world, e, Velocity, true));
+
+        const Position *p = ecs_get(world, e, Position);
+        test_assert(p != NULL);
+        test_assert(p != p_prefab);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        const Velocity *v = ecs_get(world, e, Velocity);
+        test_assert(v == v_prefab);
+    }
+
+    ecs_fini(world);
+}
+
+void Prefab_instantiate_many_children_w_nested() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t base = ecs_new_w_id(world, EcsPrefab);
+
+    /* More children than fit in the stack buffer for instantiating */
+    int i;
+    for (i = 0; i < 300; i ++) {
+        ecs_entity_t child = ecs_new_w_id(world, EcsPrefab);
+        ecs_add_pair(world, child, EcsChildOf, base);
+        ecs_set(world, child, Position, {i, i * 2});
+
+        if (i == 299) {
+            ecs_entity_t grand_child = ecs_new_w_id(world, EcsPrefab);
+            ecs_add_pair(world, grand_child, EcsChildOf, child);
+            ecs_set(world, grand_child, Velocity, {1, 2});
+        }
+    }
+
+    ecs_entity_t inst = ecs_new_w_pair(world, EcsIsA, base);
+
+    int32_t count = 0, nested = 0;
+    ecs_iter_t it = ecs_scope_iter(world, inst);
+    while (ecs_scope_next(&it)) {
+        int32_t j;
+        for (j = 0; j < it.count; j ++) {
+            ecs_entity_t child = it.entities[j];
+            const Position *p = ecs_get(world, child, Position);
+            test_assert(p != NULL);
+            test_int(p->y, p->x * 2);
+
+            ecs_iter_t cit = ecs_scope_iter(world, child);
+            while (ecs_scope_next(&cit)) {
+                test_int(cit.count, 1);
+                test_int(p->x, 299);
+                const Velocity *v = ecs_get(world, cit.entities[0], Velocity);
+                test_assert(v != NULL);
+                test_int(v->x, 1);
+                test_int(v->y, 2);
+                nested ++;
+            }
+
+            count ++;
+        }
+    }
+
+    test_int(count, 300);
+    test_int(nested, 1);
+
+    ecs_fini(world);
+}
@@ -1378,3 +1378,155 @@ void Query_group_by_w_ctx() {
 
     ecs_fini(world);
 }
+
+void Query_reactivate_table_before_iter() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    test_assert(q != NULL);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_add(world, e2, Velocity);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_int(it.table_count, 2);
+    test_int(it.inactive_table_count, 0);
+
+    /* Table becomes empty and non-empty again before the query is iterated,
+     * which should not deactivate the table */
+    ecs_delete(world, e1);
+    ecs_entity_t e3 = ecs_new(world, Position);
+
+    it = ecs_query_iter(q);
+    test_int(it.table_count, 2);
+    test_int(it.inactive_table_count, 0);
+
+    int32_t count = 0;
+    while (ecs_query_next(&it)) {
+        test_int(it.count, 1);
+        test_assert(it.entities[0] == e2 || it.entities[0] == e3);
+        count ++;
+    }
+    test_int(count, 2);
+
+    /* Table stays empty, should be deactivated when the query is iterated */
+    ecs_delete(world, e3);
+
+    it = ecs_query_iter(q);
+    test_int(it.table_count, 1);
+    test_int(it.inactive_table_count, 1);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void Query_iter_empty_table_before_deactivate() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    test_assert(q != NULL);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_int(it.table_count, 1);
+
+    ecs_delete(world, e);
+
+    /* Table that still has to be deactivated should not be returned */
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void Query_flip_table_without_iter() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    test_assert(q != NULL);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    /* Both tables flip between empty and non-empty, without the query being
+     * iterated. Only the table that ends up non-empty should be active. */
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_add(world, e, Tag);
+        ecs_remove(world, e, Tag);
+    }
+
+    test_assert(ecs_query_changed(q));
+
+    /* Deactivations are applied when the query is iterated */
+    ecs_iter_t it = ecs_query_iter(q);
+    test_int(it.table_count, 1);
+    test_int(it.inactive_table_count, 1);
+
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_assert(it.entities[0] == e);
+    test_assert(!ecs_query_next(&it));
+
+    /* Flip tables again after the deactivations were applied */
+    for (i = 0; i < 1000; i ++) {
+        ecs_add(world, e, Tag);
+        ecs_remove(world, e, Tag);
+    }
+
+    it = ecs_query_iter(q);
+    test_int(it.table_count, 1);
+    test_int(it.inactive_table_count, 1);
+
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_assert(it.entities[0] == e);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
+
+void Query_delete_table_w_pending_deactivation() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    test_assert(q != NULL);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_add(world, e2, Tag);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_int(it.table_count, 2);
+
+    /* Table with Tag becomes empty, and is deleted before the query is
+     * iterated again */
+    ecs_delete(world, e2);
+    ecs_delete(world, Tag);
+
+    it = ecs_query_iter(q);
+    test_int(it.table_count, 1);
+    test_int(it.inactive_table_count, 0);
+
+    test_assert(ecs_query_next(&it));
+    test_int(it.count, 1);
+    test_assert(it.entities[0] == e1);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_fini(world);
+}
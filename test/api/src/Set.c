@@ -627,3 +627,150 @@ void Set_emplace_existing() {
     test_expect_abort();
     ecs_emplace(world, e, Position);
 }
+
+void Set_set_many() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t entities[3];
+    entities[0] = ecs_new(world, Position);
+    entities[1] = ecs_new(world, Position);
+    entities[2] = ecs_new(world, Position);
+
+    Position values[3] = {{10, 20}, {30, 40}, {50, 60}};
+    ecs_set_many(world, entities, 3, Position, values);
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        const Position *p = ecs_get(world, entities[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, values[i].x);
+        test_int(p->y, values[i].y);
+    }
+
+    ecs_fini(world);
+}
+
+void Set_set_many_w_add() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t entities[3];
+    entities[0] = ecs_new(world, Position);
+    entities[1] = ecs_new(world, Velocity);
+    entities[2] = ecs_new(world, 0);
+
+    Position values[3] = {{10, 20}, {30, 40}, {50, 60}};
+    ecs_set_many(world, entities, 3, Position, values);
+
+    test_assert(ecs_has(world, entities[1], Velocity));
+
+    int i;
+    for (i = 0; i < 3; i ++) {
+        const Position *p = ecs_get(world, entities[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, values[i].x);
+        test_int(p->y, values[i].y);
+    }
+
+    ecs_fini(world);
+}
+
+static
+void OnSetPositionProbe(ecs_iter_t *it) {
+    probe_system(it);
+}
+
+void Set_set_many_on_set_once_per_range() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t entities[4];
+    entities[0] = ecs_new(world, Position);
+    entities[1] = ecs_new(world, Position);
+    entities[2] = ecs_new(world, Position);
+    entities[3] = ecs_new(world, Position);
+
+    ECS_SYSTEM(world, OnSetPositionProbe, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    Position values[4] = {{10, 20}, {30, 40}, {50, 60}, {70, 80}};
+    ecs_set_many(world, entities, 4, Position, values);
+
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 4);
+    test_int(ctx.e[0], entities[0]);
+    test_int(ctx.e[1], entities[1]);
+    test_int(ctx.e[2], entities[2]);
+    test_int(ctx.e[3], entities[3]);
+
+    ecs_fini(world);
+}
+
+void Set_set_many_scattered() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_entity_t e3 = ecs_new(world, Position);
+    ecs_add(world, e3, Velocity);
+    ecs_entity_t e4 = ecs_new(world, Position);
+    ecs_add(world, e4, Velocity);
+
+    ECS_SYSTEM(world, OnSetPositionProbe, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    /* Entities from different tables in mixed order */
+    ecs_entity_t entities[4] = {e4, e1, e3, e2};
+    Position values[4] = {{70, 80}, {10, 20}, {50, 60}, {30, 40}};
+    ecs_set_many(world, entities, 4, Position, values);
+
+    test_int(ctx.invoked, 2);
+    test_int(ctx.count, 4);
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    p = ecs_get(world, e2, Position);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+    p = ecs_get(world, e3, Position);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+    p = ecs_get(world, e4, Position);
+    test_int(p->x, 70);
+    test_int(p->y, 80);
+
+    ecs_fini(world);
+}
+
+void Set_set_many_same_entity_twice() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    ecs_entity_t entities[2] = {e, e};
+    Position values[2] = {{10, 20}, {30, 40}};
+    ecs_set_many(world, entities, 2, Position, values);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
@@ -852,3 +852,58 @@ void Snapshot_snapshot_w_new_in_onset_in_snapshot_table() {
 
     ecs_fini(world);
 }
+
+void Snapshot_restore_inherited_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t base = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t inst = ecs_new_w_pair(world, EcsIsA, base);
+
+    const Position *p = ecs_get(world, inst, Position);
+    test_assert(p != NULL);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_remove(world, base, Position);
+    test_assert(ecs_get(world, inst, Position) == NULL);
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(ecs_has(world, base, Position));
+    p = ecs_get(world, inst, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void Snapshot_restore_inherited_component_changed_base() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t base = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t inst = ecs_new_w_pair(world, EcsIsA, base);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    ecs_set(world, base, Velocity, {1, 2});
+    const Velocity *v = ecs_get(world, inst, Velocity);
+    test_assert(v != NULL);
+
+    ecs_snapshot_restore(world, s);
+
+    test_assert(!ecs_has(world, base, Velocity));
+    test_assert(ecs_get(world, inst, Velocity) == NULL);
+
+    const Position *p = ecs_get(world, inst, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,666 @@
+#include <api.h>
+
+static int ctor_position = 0;
+static
+ECS_CTOR(Position, ptr, {
+    ptr->x = 10;
+    ptr->y = 20;
+    ctor_position ++;
+});
+
+static int dtor_position = 0;
+static
+ECS_DTOR(Position, ptr, {
+    dtor_position ++;
+});
+
+void SparseStorage_add_tag() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ecs_entity_t e = ecs_new(world, 0);
+    test_assert(e != 0);
+    test_assert(!ecs_has(world, e, Tag));
+
+    ecs_add(world, e, Tag);
+    test_assert(ecs_has(world, e, Tag));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_remove_tag() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ecs_entity_t e = ecs_new(world, Tag);
+    test_assert(e != 0);
+    test_assert(ecs_has(world, e, Tag));
+
+    ecs_remove(world, e, Tag);
+    test_assert(!ecs_has(world, e, Tag));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_set_get() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ecs_add_id(world, ecs_id(Position), EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    test_assert(ecs_has(world, e1, Position));
+    test_assert(ecs_has(world, e2, Position));
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_set(world, e1, Position, {50, 60});
+    p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_get_mut() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ecs_add_id(world, ecs_id(Position), EcsSparse);
+
+    ecs_entity_t e = ecs_new(world, 0);
+
+    bool is_added = false;
+    Position *p = ecs_get_mut(world, e, Position, &is_added);
+    test_assert(p != NULL);
+    test_bool(is_added, true);
+    p->x = 10;
+    p->y = 20;
+
+    Position *p2 = ecs_get_mut(world, e, Position, &is_added);
+    test_assert(p == p2);
+    test_bool(is_added, false);
+    test_int(p2->x, 10);
+    test_int(p2->y, 20);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_not_in_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_type_t type = ecs_get_type(world, e);
+    test_int(ecs_vector_count(type), 1);
+    test_assert(ecs_type_has_id(world, type, ecs_id(Position)));
+    test_assert(!ecs_type_has_id(world, type, ecs_id(Velocity)));
+
+    test_assert(ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_delete_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_delete(world, e);
+    test_assert(!ecs_is_alive(world, e));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_clear_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_clear(world, e);
+    test_assert(ecs_is_alive(world, e));
+    test_assert(!ecs_has(world, e, Position));
+    test_assert(!ecs_has(world, e, Velocity));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_recycled_id() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_delete(world, e);
+
+    ecs_entity_t e2 = ecs_new(world, 0);
+    test_assert(e != e2);
+    test_assert((uint32_t)e == (uint32_t)e2);
+    test_assert(!ecs_has(world, e2, Velocity));
+    test_assert(ecs_get(world, e2, Velocity) == NULL);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_ctor_dtor() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, ecs_id(Position), EcsComponentLifecycle, {
+        .ctor = ecs_ctor(Position),
+        .dtor = ecs_dtor(Position)
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsSparse);
+
+    ctor_position = 0;
+    dtor_position = 0;
+
+    ecs_entity_t e = ecs_new(world, Position);
+    test_int(ctor_position, 1);
+    test_int(dtor_position, 0);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_remove(world, e, Position);
+    test_int(ctor_position, 1);
+    test_int(dtor_position, 1);
+
+    ecs_add(world, e, Position);
+    test_int(ctor_position, 2);
+    test_int(dtor_position, 1);
+
+    ecs_delete(world, e);
+    test_int(ctor_position, 2);
+    test_int(dtor_position, 2);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_dtor_on_fini() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_set(world, ecs_id(Position), EcsComponentLifecycle, {
+        .ctor = ecs_ctor(Position),
+        .dtor = ecs_dtor(Position)
+    });
+
+    ecs_add_id(world, ecs_id(Position), EcsSparse);
+
+    ctor_position = 0;
+    dtor_position = 0;
+
+    ecs_new(world, Position);
+    ecs_new(world, Position);
+    test_int(ctor_position, 2);
+    test_int(dtor_position, 0);
+
+    ecs_fini(world);
+
+    test_int(dtor_position, 2);
+}
+
+void SparseStorage_query_and() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {50, 60});
+    ecs_set(world, e1, Velocity, {1, 2});
+    ecs_set(world, e3, Velocity, {3, 4});
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Velocity");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    Position *p = ecs_term(&it, Position, 1);
+    Velocity *v = ecs_term(&it, Velocity, 2);
+    test_assert(p != NULL);
+    test_assert(v != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e3);
+    p = ecs_term(&it, Position, 1);
+    v = ecs_term(&it, Velocity, 2);
+    test_assert(p != NULL);
+    test_assert(v != NULL);
+    test_int(p->x, 50);
+    test_int(p->y, 60);
+    test_int(v->x, 3);
+    test_int(v->y, 4);
+
+    test_bool(ecs_query_next(&it), false);
+
+    test_assert(e2 != 0);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_and_tag() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {50, 60});
+    ecs_entity_t e4 = ecs_set(world, 0, Position, {70, 80});
+    ecs_add(world, e2, Tag);
+    ecs_add(world, e3, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Tag");
+    test_assert(q != NULL);
+
+    /* Tags have no data, so adjacent entities are returned as one range */
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 2);
+    test_int(it.entities[0], e2);
+    test_int(it.entities[1], e3);
+    Position *p = ecs_term(&it, Position, 1);
+    test_int(p[0].x, 30);
+    test_int(p[1].x, 50);
+
+    test_bool(ecs_query_next(&it), false);
+
+    test_assert(e1 != 0);
+    test_assert(e4 != 0);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_not() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {50, 60});
+    ecs_add(world, e2, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, !Tag");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e3);
+
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_optional() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_set(world, e2, Velocity, {1, 2});
+
+    ecs_query_t *q = ecs_query_new(world, "Position, ?Velocity");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    test_assert(ecs_term(&it, Velocity, 2) == NULL);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    Velocity *v = ecs_term(&it, Velocity, 2);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_empty_table() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, 0, Position, {30, 40});
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Velocity");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_sparse_only_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Stunned);
+    ecs_add_id(world, Stunned, EcsSparse);
+
+    ecs_entity_t e1 = ecs_new(world, Stunned);
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e3 = ecs_set(world, 0, Position, {30, 40});
+    ecs_add(world, e3, Stunned);
+    test_assert(ecs_get_type(world, e1) == NULL);
+
+    ecs_query_t *q = ecs_query_new(world, "Stunned");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e3);
+
+    test_bool(ecs_query_next(&it), false);
+
+    test_assert(e2 != 0);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_sparse_only_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_query_t *q = ecs_query_new(world, "Velocity");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+    Velocity *v = ecs_term(&it, Velocity, 1);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    v = ecs_term(&it, Velocity, 1);
+    test_assert(v != NULL);
+    test_int(v->x, 3);
+    test_int(v->y, 4);
+
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_sparse_only_not() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Stunned);
+    ecs_add_id(world, Stunned, EcsSparse);
+
+    ecs_entity_t e1 = ecs_new(world, Stunned);
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e2, Stunned);
+
+    ecs_query_t *q = ecs_query_new(world, "Stunned, !Position");
+    test_assert(q != NULL);
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e1);
+
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+static
+int compare_id(
+    ecs_entity_t e1,
+    const void *ptr1,
+    ecs_entity_t e2,
+    const void *ptr2)
+{
+    return (e1 > e2) - (e1 < e2);
+}
+
+void SparseStorage_query_sparse_only_order_by() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ecs_add_id(world, ecs_id(Velocity), EcsSparse);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e2, Velocity, {3, 4});
+    ecs_set(world, 0, Position, {30, 40});
+
+    /* Queries that sort tables are not iterated from the storage */
+    ecs_query_t *q = ecs_query_new(world, "Velocity");
+    test_assert(q != NULL);
+    ecs_query_order_by(world, q, 0, compare_id);
+
+    int32_t count = 0;
+    ecs_iter_t it = ecs_query_iter(q);
+    while (ecs_query_next(&it)) {
+        Velocity *v = ecs_term(&it, Velocity, 1);
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            if (it.entities[i] == e1) {
+                test_int(v[i].x, 1);
+            } else {
+                test_int(it.entities[i], e2);
+                test_int(v[i].x, 3);
+            }
+            count ++;
+        }
+    }
+
+    test_int(count, 2);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_remove_last_table_component() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Stunned);
+    ecs_add_id(world, Stunned, EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e, Stunned);
+
+    ecs_query_t *q = ecs_query_new(world, "Stunned");
+    test_assert(q != NULL);
+
+    ecs_remove(world, e, Position);
+    test_assert(!ecs_has(world, e, Position));
+    test_assert(ecs_has(world, e, Stunned));
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_remove(world, e, Stunned);
+    test_assert(!ecs_has(world, e, Stunned));
+    test_assert(ecs_is_alive(world, e));
+
+    it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_clear_sparse_only_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Stunned);
+    ecs_add_id(world, Stunned, EcsSparse);
+
+    ecs_entity_t e = ecs_new(world, Stunned);
+
+    ecs_query_t *q = ecs_query_new(world, "Stunned");
+    test_assert(q != NULL);
+
+    ecs_clear(world, e);
+    test_assert(ecs_is_alive(world, e));
+    test_assert(!ecs_has(world, e, Stunned));
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_delete_sparse_only_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Stunned);
+    ecs_add_id(world, Stunned, EcsSparse);
+
+    ecs_entity_t e1 = ecs_new(world, Stunned);
+    ecs_entity_t e2 = ecs_new(world, Stunned);
+
+    ecs_query_t *q = ecs_query_new(world, "Stunned");
+    test_assert(q != NULL);
+
+    ecs_delete(world, e1);
+    test_assert(!ecs_is_alive(world, e1));
+
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), true);
+    test_int(it.count, 1);
+    test_int(it.entities[0], e2);
+    test_bool(ecs_query_next(&it), false);
+
+    ecs_fini(world);
+}
+
+void SparseStorage_has_type() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ECS_TYPE(world, Type, Position, Tag);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_entity_t e3 = ecs_set(world, 0, Velocity, {1, 2});
+    ecs_add(world, e2, Tag);
+
+    test_assert(ecs_has_type(world, e1, ecs_type(Type)));
+    test_assert(ecs_has_type(world, e2, ecs_type(Type)));
+    test_assert(!ecs_has_type(world, e3, ecs_type(Type)));
+
+    ecs_fini(world);
+}
+
+void SparseStorage_query_after_delete_id() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+    ecs_add_id(world, Tag, EcsSparse);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e, Tag);
+
+    ecs_query_t *q = ecs_query_new(world, "Position, Tag");
+    test_assert(q != NULL);
+
+    ecs_delete(world, Tag);
+
+    /* Terms don't keep a reference to the deleted storage */
+    ecs_iter_t it = ecs_query_iter(q);
+    test_bool(ecs_query_next(&it), false);
+
+    test_assert(ecs_has(world, e, Position));
+
+    ecs_fini(world);
+}
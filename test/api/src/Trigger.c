@@ -1841,3 +1841,199 @@ void Trigger_trigger_w_index() {
     
     ecs_fini(world);
 }
+
+void Trigger_add_trigger_after_notify() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+
+    Probe ctx_1 = {0};
+    ecs_entity_t t_1 = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = TagA,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx_1
+    });
+    test_assert(t_1 != 0);
+
+    ecs_new(world, TagA);
+    test_int(ctx_1.invoked, 1);
+
+    /* Table has triggers cached for TagA, new trigger should be notified */
+    Probe ctx_2 = {0};
+    ecs_entity_t t_2 = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = EcsWildcard,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx_2
+    });
+    test_assert(t_2 != 0);
+
+    ecs_entity_t e = ecs_new(world, TagA);
+    test_int(ctx_1.invoked, 2);
+    test_int(ctx_2.invoked, 1);
+    test_int(ctx_2.system, t_2);
+    test_int(ctx_2.event_id, TagA);
+    test_int(ctx_2.e[0], e);
+
+    ecs_fini(world);
+}
+
+void Trigger_delete_trigger_after_notify() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+
+    Probe ctx_1 = {0};
+    ecs_entity_t t_1 = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = TagA,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx_1
+    });
+    test_assert(t_1 != 0);
+
+    Probe ctx_2 = {0};
+    ecs_entity_t t_2 = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = TagA,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx_2
+    });
+    test_assert(t_2 != 0);
+
+    ecs_new(world, TagA);
+    test_int(ctx_1.invoked, 1);
+    test_int(ctx_2.invoked, 1);
+
+    /* Deleted trigger should no longer be notified by table */
+    ecs_delete(world, t_1);
+
+    ecs_new(world, TagA);
+    test_int(ctx_1.invoked, 1);
+    test_int(ctx_2.invoked, 2);
+
+    ecs_fini(world);
+}
+
+void Trigger_wildcard_trigger_after_table_created() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Pred);
+    ECS_TAG(world, Obj);
+
+    /* Create table before trigger is registered */
+    ecs_entity_t e1 = ecs_new_w_pair(world, Pred, Obj);
+    test_assert(e1 != 0);
+    ecs_remove_pair(world, e1, Pred, Obj);
+
+    Probe ctx = {0};
+    ecs_entity_t t = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = ecs_pair(EcsWildcard, Obj),
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx
+    });
+
+    ecs_add_pair(world, e1, Pred, Obj);
+
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.system, t);
+    test_int(ctx.event, EcsOnAdd);
+    test_int(ctx.event_id, ecs_pair(Pred, Obj));
+    test_int(ctx.e[0], e1);
+
+    ecs_fini(world);
+}
+
+void Trigger_delete_wildcard_trigger() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    Probe ctx = {0};
+    ecs_entity_t t = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = EcsWildcard,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx
+    });
+
+    ecs_entity_t e = ecs_new_id(world);
+    ecs_add_id(world, e, TagA);
+    test_int(ctx.invoked, 1);
+
+    ecs_delete(world, t);
+
+    ctx = (Probe){0};
+    ecs_add_id(world, e, TagB);
+    test_int(ctx.invoked, 0);
+
+    /* Register trigger again after counter went back to 0 */
+    ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = EcsWildcard,
+        .events = {EcsOnAdd},
+        .callback = Trigger,
+        .ctx = &ctx
+    });
+
+    ecs_remove_id(world, e, TagB);
+    ecs_add_id(world, e, TagB);
+    test_int(ctx.invoked, 1);
+    test_int(ctx.event_id, TagB);
+
+    ecs_fini(world);
+}
+
+static ecs_entity_t trigger_to_delete[2];
+static int32_t trigger_invoked[2];
+
+static
+void DeleteOtherTrigger(ecs_iter_t *it) {
+    int32_t index = *(int32_t*)it->ctx;
+    trigger_invoked[index] ++;
+    if (trigger_to_delete[!index]) {
+        /* Delete the trigger while the triggers are being notified */
+        ecs_defer_end(it->world);
+        ecs_delete(it->world, trigger_to_delete[!index]);
+        ecs_defer_begin(it->world);
+        trigger_to_delete[!index] = 0;
+    }
+}
+
+void Trigger_delete_trigger_from_trigger() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+
+    /* Populate the trigger cache of the table */
+    ecs_entity_t e = ecs_new(world, TagA);
+    ecs_remove(world, e, TagA);
+
+    int32_t index_0 = 0, index_1 = 1;
+    trigger_to_delete[0] = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = TagA,
+        .events = {EcsOnAdd},
+        .callback = DeleteOtherTrigger,
+        .ctx = &index_0
+    });
+    trigger_to_delete[1] = ecs_trigger_init(world, &(ecs_trigger_desc_t){
+        .term.id = TagA,
+        .events = {EcsOnAdd},
+        .callback = DeleteOtherTrigger,
+        .ctx = &index_1
+    });
+
+    /* The trigger that is invoked first deletes the other trigger, which
+     * should no longer be invoked */
+    ecs_add(world, e, TagA);
+    test_int(trigger_invoked[0] + trigger_invoked[1], 1);
+
+    ecs_remove(world, e, TagA);
+    ecs_add(world, e, TagA);
+    test_int(trigger_invoked[0] + trigger_invoked[1], 2);
+
+    ecs_fini(world);
+}
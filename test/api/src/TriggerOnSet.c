@@ -573,3 +573,118 @@ void TriggerOnSet_emplace() {
 
     ecs_fini(world);
 }
+
+void TriggerOnSet_coalesce_set_same_entity() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, OnSet, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    test_bool(ecs_enable_on_set_coalescing(world, true), false);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_set(world, e, Position, {20, 30});
+    ecs_modified(world, e, Position);
+    test_int(ctx.invoked, 0);
+    ecs_defer_end(world);
+
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 1);
+    test_int(ctx.system, OnSet);
+    test_int(ctx.e[0], e);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 21);
+    test_int(p->y, 30);
+
+    ecs_fini(world);
+}
+
+void TriggerOnSet_coalesce_set_batch() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, OnSet, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_enable_on_set_coalescing(world, true);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+    ecs_entity_t e3 = ecs_new(world, Position);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e3, Position, {10, 20});
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_set(world, e2, Position, {10, 20});
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_defer_end(world);
+
+    test_int(ctx.invoked, 1);
+    test_int(ctx.count, 3);
+    test_int(ctx.e[0], e1);
+    test_int(ctx.e[1], e2);
+    test_int(ctx.e[2], e3);
+
+    ecs_fini(world);
+}
+
+void TriggerOnSet_coalesce_set_remove() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, OnSet, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_enable_on_set_coalescing(world, true);
+
+    ecs_entity_t e1 = ecs_new(world, Position);
+    ecs_entity_t e2 = ecs_new(world, Position);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_set(world, e2, Position, {10, 20});
+    ecs_remove(world, e1, Position);
+    ecs_delete(world, e2);
+    ecs_defer_end(world);
+
+    test_int(ctx.invoked, 0);
+
+    ecs_fini(world);
+}
+
+void TriggerOnSet_coalesce_disabled() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ECS_SYSTEM(world, OnSet, EcsOnSet, Position);
+
+    Probe ctx = {0};
+    ecs_set_context(world, &ctx);
+
+    ecs_entity_t e = ecs_new(world, Position);
+
+    ecs_defer_begin(world);
+    ecs_set(world, e, Position, {10, 20});
+    ecs_set(world, e, Position, {20, 30});
+    ecs_defer_end(world);
+
+    test_int(ctx.invoked, 2);
+
+    ecs_fini(world);
+}
@@ -1036,3 +1036,235 @@ void World_system_time_scale() {
 
     ecs_fini(world);
 }
+
+void World_compact() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e[1000];
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        e[i] = ecs_set(world, 0, Position, {i, i * 2});
+    }
+
+    for (i = 10; i < 1000; i ++) {
+        ecs_delete(world, e[i]);
+    }
+
+    test_assert(ecs_compact(world) > 0);
+
+    for (i = 0; i < 10; i ++) {
+        test_assert(ecs_is_alive(world, e[i]));
+        const Position *p = ecs_get(world, e[i], Position);
+        test_assert(p != NULL);
+        test_int(p->x, i);
+        test_int(p->y, i * 2);
+    }
+
+    for (i = 10; i < 1000; i ++) {
+        test_assert(!ecs_is_alive(world, e[i]));
+    }
+
+    /* Table can grow again after compacting */
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    const Position *p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_fini(world);
+}
+
+void World_compact_recycle() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_delete(world, e1);
+
+    ecs_compact(world);
+
+    /* Id of deleted entity is recycled, as e2 is still alive */
+    ecs_entity_t e3 = ecs_new(world, 0);
+    test_assert(e3 != e1);
+    test_int((uint32_t)e3, (uint32_t)e1);
+    test_assert(!ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+    test_assert(ecs_is_alive(world, e3));
+
+    ecs_fini(world);
+}
+
+void World_compact_ref() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_delete(world, e2);
+
+    ecs_ref_t ref = {0};
+    const Position *p = ecs_get_ref(world, &ref, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+
+    ecs_compact(world);
+
+    p = ecs_get_ref(world, &ref, e, Position);
+    test_assert(p != NULL);
+    test_assert(p == ecs_get(world, e, Position));
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void World_growth_policy_linear() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.malloc_ = test_malloc;
+    os_api.calloc_ = test_calloc;
+    os_api.realloc_ = test_realloc;
+    ecs_os_set_api(&os_api);    
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_dim(world, 2000);
+    ecs_set_growth_policy(world, &(ecs_growth_policy_t){
+        .factor = 2, .linear_threshold = 4, .linear_step = 1000
+    });
+
+    int i;
+    for (i = 0; i < 5; i ++) {
+        ecs_new(world, Position);
+    }
+
+    /* Table grew from 4 to 1004 elements */
+    malloc_count = 0;
+
+    for (i = 0; i < 999; i ++) {
+        ecs_new(world, Position);
+    }
+
+    test_int(malloc_count, 0);
+
+    ecs_fini(world);
+}
+
+void World_growth_policy_max_slack() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.malloc_ = test_malloc;
+    os_api.calloc_ = test_calloc;
+    os_api.realloc_ = test_realloc;
+    ecs_os_set_api(&os_api);    
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_dim(world, 2000);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_new(world, Position);
+    }
+
+    /* Table has room for 128 elements, so with the default policy adding 10
+     * elements doesn't allocate */
+    malloc_count = 0;
+    for (i = 0; i < 10; i ++) {
+        ecs_new(world, Position);
+    }
+    test_int(malloc_count, 0);
+
+    ecs_compact(world);
+
+    ecs_set_growth_policy(world, &(ecs_growth_policy_t){
+        .factor = 2, .max_slack = 4
+    });
+
+    /* With a slack of 4 elements the table grows every 5 elements */
+    malloc_count = 0;
+    for (i = 0; i < 10; i ++) {
+        ecs_new(world, Position);
+    }
+    test_assert(malloc_count != 0);
+
+    ecs_fini(world);
+}
+
+void World_type_growth_policy() {
+    ecs_os_set_api_defaults();
+    ecs_os_api_t os_api = ecs_os_api;
+    os_api.malloc_ = test_malloc;
+    os_api.calloc_ = test_calloc;
+    os_api.realloc_ = test_realloc;
+    ecs_os_set_api(&os_api);    
+
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_dim(world, 2000);
+    ecs_set_type_growth_policy(world, ecs_type(Position), 
+        &(ecs_growth_policy_t){
+            .factor = 2, .linear_threshold = 1, .linear_step = 1000
+        });
+
+    /* Table grows from 2 to 1002 elements on the third entity */
+    int i;
+    for (i = 0; i < 3; i ++) {
+        ecs_new(world, Position);
+    }
+    ecs_new(world, Velocity);
+
+    malloc_count = 0;
+    for (i = 0; i < 500; i ++) {
+        ecs_new(world, Position);
+    }
+    test_int(malloc_count, 0);
+
+    /* Velocity table uses the default policy */
+    for (i = 0; i < 500; i ++) {
+        ecs_new(world, Velocity);
+    }
+    test_assert(malloc_count != 0);
+
+    /* Reset to world policy */
+    ecs_set_type_growth_policy(world, ecs_type(Position), NULL);
+
+    ecs_fini(world);
+}
+
+void World_dim_type_exact() {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_dim_type(world, ecs_type(Position), 1000);
+
+    /* Reserving storage must not make the table active */
+    ecs_query_t *q = ecs_query_new(world, "Position");
+    ecs_iter_t it = ecs_query_iter(q);
+    test_assert(!ecs_query_next(&it));
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    /* Storage was sized exactly, compacting a table that has room for 1000
+     * elements releases memory for 999 */
+    test_assert(ecs_compact(world) >= 999 * ECS_SIZEOF(Position));
+
+    ecs_fini(world);
+}
@@ -219,6 +219,32 @@ void EnabledComponents_query_randomized_4_bitsets(void);
 void EnabledComponents_defer_enable(void);
 void EnabledComponents_sort(void);
 
+// Testsuite 'SparseStorage'
+void SparseStorage_add_tag(void);
+void SparseStorage_remove_tag(void);
+void SparseStorage_set_get(void);
+void SparseStorage_get_mut(void);
+void SparseStorage_not_in_table(void);
+void SparseStorage_delete_entity(void);
+void SparseStorage_clear_entity(void);
+void SparseStorage_recycled_id(void);
+void SparseStorage_ctor_dtor(void);
+void SparseStorage_dtor_on_fini(void);
+void SparseStorage_query_and(void);
+void SparseStorage_query_and_tag(void);
+void SparseStorage_query_not(void);
+void SparseStorage_query_optional(void);
+void SparseStorage_query_empty_table(void);
+void SparseStorage_query_sparse_only_entity(void);
+void SparseStorage_query_sparse_only_component(void);
+void SparseStorage_query_sparse_only_not(void);
+void SparseStorage_query_sparse_only_order_by(void);
+void SparseStorage_remove_last_table_component(void);
+void SparseStorage_clear_sparse_only_entity(void);
+void SparseStorage_delete_sparse_only_entity(void);
+void SparseStorage_has_type(void);
+void SparseStorage_query_after_delete_id(void);
+
 // Testsuite 'Remove'
 void Remove_zero(void);
 void Remove_zero_from_nonzero(void);
@@ -441,6 +467,15 @@ void Hierarchies_cascade_after_recycled_parent_change(void);
 void Hierarchies_long_name_depth_0(void);
 void Hierarchies_long_name_depth_1(void);
 void Hierarchies_long_name_depth_2(void);
+void Hierarchies_get_child_count_after_remove(void);
+void Hierarchies_get_child_count_after_reparent(void);
+void Hierarchies_get_child_count_bulk(void);
+void Hierarchies_get_child_count_after_delete_parent(void);
+void Hierarchies_scope_iter_skip_empty_tables(void);
+void Hierarchies_scope_iter_delete_while_iterating(void);
+void Hierarchies_delete_tree_w_dtor_many_children(void);
+void Hierarchies_delete_deep_tree(void);
+void Hierarchies_delete_tree_onremove_order(void);
 
 // Testsuite 'Add_bulk'
 void Add_bulk_add_comp_from_comp_to_empty(void);
@@ -520,6 +555,10 @@ void Get_component_get_1_from_2_add_in_progress(void);
 void Get_component_get_both_from_2_add_in_progress(void);
 void Get_component_get_both_from_2_add_remove_in_progress(void);
 void Get_component_get_childof_component(void);
+void Get_component_get_many(void);
+void Get_component_get_many_w_missing(void);
+void Get_component_get_many_from_base(void);
+void Get_component_get_many_mixed_tables(void);
 
 // Testsuite 'Reference'
 void Reference_setup(void);
@@ -565,6 +604,12 @@ void Delete_get_alive_for_nonexistent(void);
 void Delete_move_w_dtor_move(void);
 void Delete_move_w_dtor_no_move(void);
 void Delete_move_w_no_dtor_move(void);
+void Delete_delete_n(void);
+void Delete_delete_n_multiple_tables(void);
+void Delete_delete_n_w_on_remove(void);
+void Delete_delete_n_w_dtor(void);
+void Delete_delete_n_w_duplicate(void);
+void Delete_delete_n_not_alive(void);
 
 // Testsuite 'OnDelete'
 void OnDelete_on_delete_id_default(void);
@@ -656,6 +701,11 @@ void Set_get_mut_w_add_in_on_add(void);
 void Set_get_mut_w_remove_in_on_add(void);
 void Set_emplace(void);
 void Set_emplace_existing(void);
+void Set_set_many(void);
+void Set_set_many_w_add(void);
+void Set_set_many_on_set_once_per_range(void);
+void Set_set_many_scattered(void);
+void Set_set_many_same_entity_twice(void);
 
 // Testsuite 'Lookup'
 void Lookup_setup(void);
@@ -686,6 +736,17 @@ void Lookup_lookup_path_this(void);
 void Lookup_lookup_path_wildcard(void);
 void Lookup_lookup_path_this_from_scope(void);
 void Lookup_lookup_path_wildcard_from_scope(void);
+void Lookup_lookup_after_rename(void);
+void Lookup_lookup_after_reparent(void);
+void Lookup_lookup_after_delete(void);
+void Lookup_lookup_after_add_component(void);
+void Lookup_lookup_symbol_after_set_symbol(void);
+void Lookup_lookup_many_children(void);
+void Lookup_lookup_after_many_renames(void);
+void Lookup_lookup_after_emplace_name(void);
+void Lookup_lookup_after_modified_name(void);
+void Lookup_lookup_after_get_mut_name(void);
+void Lookup_lookup_symbol_after_get_mut_symbol(void);
 
 // Testsuite 'Singleton'
 void Singleton_set(void);
@@ -776,6 +837,7 @@ void ComponentLifecycle_delete_self_in_dtor_on_delete_parent(void);
 void ComponentLifecycle_delete_in_dtor_same_type_on_delete(void);
 void ComponentLifecycle_delete_in_dtor_other_type_on_delete(void);
 void ComponentLifecycle_delete_self_in_dtor_on_delete(void);
+void ComponentLifecycle_copy_on_bulk_override(void);
 
 // Testsuite 'Pipeline'
 void Pipeline_setup(void);
@@ -986,6 +1048,10 @@ void Query_only_not_from_singleton(void);
 void Query_get_filter(void);
 void Query_group_by(void);
 void Query_group_by_w_ctx(void);
+void Query_reactivate_table_before_iter(void);
+void Query_iter_empty_table_before_deactivate(void);
+void Query_flip_table_without_iter(void);
+void Query_delete_table_w_pending_deactivation(void);
 
 // Testsuite 'Pairs'
 void Pairs_type_w_one_pair(void);
@@ -1047,6 +1113,8 @@ void Pairs_get_tag_pair_w_obj_comp(void);
 void Pairs_get_tag_pair_w_rel_obj_comp(void);
 void Pairs_tag_pair_w_childof_w_comp(void);
 void Pairs_tag_pair_w_isa_w_comp(void);
+void Pairs_get_object_for_rel(void);
+void Pairs_query_2_pairs_w_pred_wildcard(void);
 
 // Testsuite 'Trigger'
 void Trigger_on_add_trigger_before_table(void);
@@ -1098,6 +1166,11 @@ void Trigger_set_get_binding_context(void);
 void Trigger_trigger_w_self(void);
 void Trigger_delete_trigger_w_delete_ctx(void);
 void Trigger_trigger_w_index(void);
+void Trigger_add_trigger_after_notify(void);
+void Trigger_delete_trigger_after_notify(void);
+void Trigger_wildcard_trigger_after_table_created(void);
+void Trigger_delete_wildcard_trigger(void);
+void Trigger_delete_trigger_from_trigger(void);
 
 // Testsuite 'Observer'
 void Observer_2_terms_w_on_add(void);
@@ -1184,6 +1257,10 @@ void TriggerOnSet_on_set_after_override_w_new_w_count(void);
 void TriggerOnSet_on_set_after_override_1_of_2_overridden(void);
 void TriggerOnSet_on_set_after_snapshot_restore(void);
 void TriggerOnSet_emplace(void);
+void TriggerOnSet_coalesce_set_same_entity(void);
+void TriggerOnSet_coalesce_set_batch(void);
+void TriggerOnSet_coalesce_set_remove(void);
+void TriggerOnSet_coalesce_disabled(void);
 
 // Testsuite 'Monitor'
 void Monitor_1_comp(void);
@@ -1455,6 +1532,13 @@ void Prefab_override_from_recycled_base(void);
 void Prefab_remove_override_from_recycled_base(void);
 void Prefab_instantiate_tree_from_recycled_base(void);
 void Prefab_rematch_after_add_to_recycled_base(void);
+void Prefab_rematch_after_add_to_nested_base(void);
+void Prefab_rematch_after_add_to_2_bases(void);
+void Prefab_bulk_instantiate_w_children(void);
+void Prefab_get_from_base_after_override_in_nested_base(void);
+void Prefab_get_from_base_after_base_moved(void);
+void Prefab_bulk_new_w_override(void);
+void Prefab_instantiate_many_children_w_nested(void);
 
 // Testsuite 'System_w_FromContainer'
 void System_w_FromContainer_setup(void);
@@ -1529,6 +1613,13 @@ void World_no_threading(void);
 void World_no_time(void);
 void World_is_entity_enabled(void);
 void World_get_stats(void);
+void World_compact(void);
+void World_compact_ref(void);
+void World_growth_policy_linear(void);
+void World_growth_policy_max_slack(void);
+void World_type_growth_policy(void);
+void World_dim_type_exact(void);
+void World_compact_recycle(void);
 
 // Testsuite 'Type'
 void Type_setup(void);
@@ -1688,6 +1779,7 @@ void MultiThread_multithread_quit(void);
 void MultiThread_schedule_w_tasks(void);
 void MultiThread_reactive_system(void);
 void MultiThread_fini_after_set_threads(void);
+void MultiThread_cascade_level_barrier(void);
 
 // Testsuite 'DeferredActions'
 void DeferredActions_defer_new(void);
@@ -1822,6 +1914,8 @@ void MultiThreadStaging_new_w_count(void);
 void MultiThreadStaging_custom_thread_auto_merge(void);
 void MultiThreadStaging_custom_thread_manual_merge(void);
 void MultiThreadStaging_custom_thread_partial_manual_merge(void);
+void MultiThreadStaging_new_id_from_stages_unique(void);
+void MultiThreadStaging_new_id_from_stage_recycle(void);
 
 // Testsuite 'Stresstests'
 void Stresstests_setup(void);
@@ -1868,6 +1962,8 @@ void Snapshot_set_after_snapshot(void);
 void Snapshot_restore_recycled(void);
 void Snapshot_snapshot_w_new_in_onset(void);
 void Snapshot_snapshot_w_new_in_onset_in_snapshot_table(void);
+void Snapshot_restore_inherited_component(void);
+void Snapshot_restore_inherited_component_changed_base(void);
 
 // Testsuite 'ReaderWriter'
 void ReaderWriter_simple(void);
@@ -2791,6 +2887,105 @@ bake_test_case EnabledComponents_testcases[] = {
     }
 };
 
+bake_test_case SparseStorage_testcases[] = {
+    {
+        "add_tag",
+        SparseStorage_add_tag
+    },
+    {
+        "remove_tag",
+        SparseStorage_remove_tag
+    },
+    {
+        "set_get",
+        SparseStorage_set_get
+    },
+    {
+        "get_mut",
+        SparseStorage_get_mut
+    },
+    {
+        "not_in_table",
+        SparseStorage_not_in_table
+    },
+    {
+        "delete_entity",
+        SparseStorage_delete_entity
+    },
+    {
+        "clear_entity",
+        SparseStorage_clear_entity
+    },
+    {
+        "recycled_id",
+        SparseStorage_recycled_id
+    },
+    {
+        "ctor_dtor",
+        SparseStorage_ctor_dtor
+    },
+    {
+        "dtor_on_fini",
+        SparseStorage_dtor_on_fini
+    },
+    {
+        "query_and",
+        SparseStorage_query_and
+    },
+    {
+        "query_and_tag",
+        SparseStorage_query_and_tag
+    },
+    {
+        "query_not",
+        SparseStorage_query_not
+    },
+    {
+        "query_optional",
+        SparseStorage_query_optional
+    },
+    {
+        "query_empty_table",
+        SparseStorage_query_empty_table
+    },
+    {
+        "query_sparse_only_entity",
+        SparseStorage_query_sparse_only_entity
+    },
+    {
+        "query_sparse_only_component",
+        SparseStorage_query_sparse_only_component
+    },
+    {
+        "query_sparse_only_not",
+        SparseStorage_query_sparse_only_not
+    },
+    {
+        "query_sparse_only_order_by",
+        SparseStorage_query_sparse_only_order_by
+    },
+    {
+        "remove_last_table_component",
+        SparseStorage_remove_last_table_component
+    },
+    {
+        "clear_sparse_only_entity",
+        SparseStorage_clear_sparse_only_entity
+    },
+    {
+        "delete_sparse_only_entity",
+        SparseStorage_delete_sparse_only_entity
+    },
+    {
+        "has_type",
+        SparseStorage_has_type
+    },
+    {
+        "query_after_delete_id",
+        SparseStorage_query_after_delete_id
+    }
+};
+
 bake_test_case Remove_testcases[] = {
     {
         "zero",
@@ -3656,6 +3851,42 @@ bake_test_case Hierarchies_testcases[] = {
     {
         "long_name_depth_2",
         Hierarchies_long_name_depth_2
+    },
+    {
+        "get_child_count_after_remove",
+        Hierarchies_get_child_count_after_remove
+    },
+    {
+        "get_child_count_after_reparent",
+        Hierarchies_get_child_count_after_reparent
+    },
+    {
+        "get_child_count_bulk",
+        Hierarchies_get_child_count_bulk
+    },
+    {
+        "get_child_count_after_delete_parent",
+        Hierarchies_get_child_count_after_delete_parent
+    },
+    {
+        "scope_iter_skip_empty_tables",
+        Hierarchies_scope_iter_skip_empty_tables
+    },
+    {
+        "scope_iter_delete_while_iterating",
+        Hierarchies_scope_iter_delete_while_iterating
+    },
+    {
+        "delete_tree_w_dtor_many_children",
+        Hierarchies_delete_tree_w_dtor_many_children
+    },
+    {
+        "delete_deep_tree",
+        Hierarchies_delete_deep_tree
+    },
+    {
+        "delete_tree_onremove_order",
+        Hierarchies_delete_tree_onremove_order
     }
 };
 
@@ -3938,6 +4169,22 @@ bake_test_case Get_component_testcases[] = {
     {
         "get_childof_component",
         Get_component_get_childof_component
+    },
+    {
+        "get_many",
+        Get_component_get_many
+    },
+    {
+        "get_many_w_missing",
+        Get_component_get_many_w_missing
+    },
+    {
+        "get_many_from_base",
+        Get_component_get_many_from_base
+    },
+    {
+        "get_many_mixed_tables",
+        Get_component_get_many_mixed_tables
     }
 };
 
@@ -4100,6 +4347,30 @@ bake_test_case Delete_testcases[] = {
     {
         "move_w_no_dtor_move",
         Delete_move_w_no_dtor_move
+    },
+    {
+        "delete_n",
+        Delete_delete_n
+    },
+    {
+        "delete_n_multiple_tables",
+        Delete_delete_n_multiple_tables
+    },
+    {
+        "delete_n_w_on_remove",
+        Delete_delete_n_w_on_remove
+    },
+    {
+        "delete_n_w_dtor",
+        Delete_delete_n_w_dtor
+    },
+    {
+        "delete_n_w_duplicate",
+        Delete_delete_n_w_duplicate
+    },
+    {
+        "delete_n_not_alive",
+        Delete_delete_n_not_alive
     }
 };
 
@@ -4449,6 +4720,26 @@ bake_test_case Set_testcases[] = {
     {
         "emplace_existing",
         Set_emplace_existing
+    },
+    {
+        "set_many",
+        Set_set_many
+    },
+    {
+        "set_many_w_add",
+        Set_set_many_w_add
+    },
+    {
+        "set_many_on_set_once_per_range",
+        Set_set_many_on_set_once_per_range
+    },
+    {
+        "set_many_scattered",
+        Set_set_many_scattered
+    },
+    {
+        "set_many_same_entity_twice",
+        Set_set_many_same_entity_twice
     }
 };
 
@@ -4560,6 +4851,50 @@ bake_test_case Lookup_testcases[] = {
     {
         "lookup_path_wildcard_from_scope",
         Lookup_lookup_path_wildcard_from_scope
+    },
+    {
+        "lookup_after_rename",
+        Lookup_lookup_after_rename
+    },
+    {
+        "lookup_after_reparent",
+        Lookup_lookup_after_reparent
+    },
+    {
+        "lookup_after_delete",
+        Lookup_lookup_after_delete
+    },
+    {
+        "lookup_after_add_component",
+        Lookup_lookup_after_add_component
+    },
+    {
+        "lookup_symbol_after_set_symbol",
+        Lookup_lookup_symbol_after_set_symbol
+    },
+    {
+        "lookup_many_children",
+        Lookup_lookup_many_children
+    },
+    {
+        "lookup_after_many_renames",
+        Lookup_lookup_after_many_renames
+    },
+    {
+        "lookup_after_emplace_name",
+        Lookup_lookup_after_emplace_name
+    },
+    {
+        "lookup_after_modified_name",
+        Lookup_lookup_after_modified_name
+    },
+    {
+        "lookup_after_get_mut_name",
+        Lookup_lookup_after_get_mut_name
+    },
+    {
+        "lookup_symbol_after_get_mut_symbol",
+        Lookup_lookup_symbol_after_get_mut_symbol
     }
 };
 
@@ -4901,6 +5236,10 @@ bake_test_case ComponentLifecycle_testcases[] = {
     {
         "delete_self_in_dtor_on_delete",
         ComponentLifecycle_delete_self_in_dtor_on_delete
+    },
+    {
+        "copy_on_bulk_override",
+        ComponentLifecycle_copy_on_bulk_override
     }
 };
 
@@ -5708,6 +6047,22 @@ bake_test_case Query_testcases[] = {
     {
         "group_by_w_ctx",
         Query_group_by_w_ctx
+    },
+    {
+        "reactivate_table_before_iter",
+        Query_reactivate_table_before_iter
+    },
+    {
+        "iter_empty_table_before_deactivate",
+        Query_iter_empty_table_before_deactivate
+    },
+    {
+        "flip_table_without_iter",
+        Query_flip_table_without_iter
+    },
+    {
+        "delete_table_w_pending_deactivation",
+        Query_delete_table_w_pending_deactivation
     }
 };
 
@@ -5947,6 +6302,14 @@ bake_test_case Pairs_testcases[] = {
     {
         "tag_pair_w_isa_w_comp",
         Pairs_tag_pair_w_isa_w_comp
+    },
+    {
+        "get_object_for_rel",
+        Pairs_get_object_for_rel
+    },
+    {
+        "query_2_pairs_w_pred_wildcard",
+        Pairs_query_2_pairs_w_pred_wildcard
     }
 };
 
@@ -6146,6 +6509,26 @@ bake_test_case Trigger_testcases[] = {
     {
         "trigger_w_index",
         Trigger_trigger_w_index
+    },
+    {
+        "add_trigger_after_notify",
+        Trigger_add_trigger_after_notify
+    },
+    {
+        "delete_trigger_after_notify",
+        Trigger_delete_trigger_after_notify
+    },
+    {
+        "wildcard_trigger_after_table_created",
+        Trigger_wildcard_trigger_after_table_created
+    },
+    {
+        "delete_wildcard_trigger",
+        Trigger_delete_wildcard_trigger
+    },
+    {
+        "delete_trigger_from_trigger",
+        Trigger_delete_trigger_from_trigger
     }
 };
 
@@ -6466,6 +6849,22 @@ bake_test_case TriggerOnSet_testcases[] = {
     {
         "emplace",
         TriggerOnSet_emplace
+    },
+    {
+        "coalesce_set_same_entity",
+        TriggerOnSet_coalesce_set_same_entity
+    },
+    {
+        "coalesce_set_batch",
+        TriggerOnSet_coalesce_set_batch
+    },
+    {
+        "coalesce_set_remove",
+        TriggerOnSet_coalesce_set_remove
+    },
+    {
+        "coalesce_disabled",
+        TriggerOnSet_coalesce_disabled
     }
 };
 
@@ -7492,6 +7891,34 @@ bake_test_case Prefab_testcases[] = {
     {
         "rematch_after_add_to_recycled_base",
         Prefab_rematch_after_add_to_recycled_base
+    },
+    {
+        "rematch_after_add_to_nested_base",
+        Prefab_rematch_after_add_to_nested_base
+    },
+    {
+        "rematch_after_add_to_2_bases",
+        Prefab_rematch_after_add_to_2_bases
+    },
+    {
+        "bulk_instantiate_w_children",
+        Prefab_bulk_instantiate_w_children
+    },
+    {
+        "get_from_base_after_override_in_nested_base",
+        Prefab_get_from_base_after_override_in_nested_base
+    },
+    {
+        "get_from_base_after_base_moved",
+        Prefab_get_from_base_after_base_moved
+    },
+    {
+        "bulk_new_w_override",
+        Prefab_bulk_new_w_override
+    },
+    {
+        "instantiate_many_children_w_nested",
+        Prefab_instantiate_many_children_w_nested
     }
 };
 
@@ -7755,6 +8182,34 @@ bake_test_case World_testcases[] = {
     {
         "get_stats",
         World_get_stats
+    },
+    {
+        "compact",
+        World_compact
+    },
+    {
+        "compact_ref",
+        World_compact_ref
+    },
+    {
+        "growth_policy_linear",
+        World_growth_policy_linear
+    },
+    {
+        "growth_policy_max_slack",
+        World_growth_policy_max_slack
+    },
+    {
+        "type_growth_policy",
+        World_type_growth_policy
+    },
+    {
+        "dim_type_exact",
+        World_dim_type_exact
+    },
+    {
+        "compact_recycle",
+        World_compact_recycle
     }
 };
 
@@ -8364,6 +8819,10 @@ bake_test_case MultiThread_testcases[] = {
     {
         "fini_after_set_threads",
         MultiThread_fini_after_set_threads
+    },
+    {
+        "cascade_level_barrier",
+        MultiThread_cascade_level_barrier
     }
 };
 
@@ -8877,6 +9336,14 @@ bake_test_case MultiThreadStaging_testcases[] = {
     {
         "custom_thread_partial_manual_merge",
         MultiThreadStaging_custom_thread_partial_manual_merge
+    },
+    {
+        "new_id_from_stages_unique",
+        MultiThreadStaging_new_id_from_stages_unique
+    },
+    {
+        "new_id_from_stage_recycle",
+        MultiThreadStaging_new_id_from_stage_recycle
     }
 };
 
@@ -9047,6 +9514,14 @@ bake_test_case Snapshot_testcases[] = {
     {
         "snapshot_w_new_in_onset_in_snapshot_table",
         Snapshot_snapshot_w_new_in_onset_in_snapshot_table
+    },
+    {
+        "restore_inherited_component",
+        Snapshot_restore_inherited_component
+    },
+    {
+        "restore_inherited_component_changed_base",
+        Snapshot_restore_inherited_component_changed_base
     }
 };
 
@@ -9510,6 +9985,13 @@ static bake_test_suite suites[] = {
         37,
         EnabledComponents_testcases
     },
+    {
+        "SparseStorage",
+        NULL,
+        NULL,
+        24,
+        SparseStorage_testcases
+    },
     {
         "Remove",
         NULL,
@@ -9535,7 +10017,7 @@ static bake_test_suite suites[] = {
         "Hierarchies",
         Hierarchies_setup,
         NULL,
-        85,
+        94,
         Hierarchies_testcases
     },
     {
@@ -9577,7 +10059,7 @@ static bake_test_suite suites[] = {
         "Get_component",
         Get_component_setup,
         NULL,
-        10,
+        14,
         Get_component_testcases
     },
     {
@@ -9591,7 +10073,7 @@ static bake_test_suite suites[] = {
         "Delete",
         Delete_setup,
         NULL,
-        29,
+        35,
         Delete_testcases
     },
     {
@@ -9612,14 +10094,14 @@ static bake_test_suite suites[] = {
         "Set",
         NULL,
         NULL,
-        27,
+        32,
         Set_testcases
     },
     {
         "Lookup",
         Lookup_setup,
         NULL,
-        27,
+        38,
         Lookup_testcases
     },
     {
@@ -9640,7 +10122,7 @@ static bake_test_suite suites[] = {
         "ComponentLifecycle",
         ComponentLifecycle_setup,
         NULL,
-        59,
+        60,
         ComponentLifecycle_testcases
     },
     {
@@ -9675,21 +10157,21 @@ static bake_test_suite suites[] = {
         "Query",
         NULL,
         NULL,
-        39,
+        43,
         Query_testcases
     },
     {
         "Pairs",
         NULL,
         NULL,
-        59,
+        61,
         Pairs_testcases
     },
     {
         "Trigger",
         NULL,
         NULL,
-        49,
+        54,
         Trigger_testcases
     },
     {
@@ -9717,7 +10199,7 @@ static bake_test_suite suites[] = {
         "TriggerOnSet",
         NULL,
         NULL,
-        12,
+        16,
         TriggerOnSet_testcases
     },
     {
@@ -9787,7 +10269,7 @@ static bake_test_suite suites[] = {
         "Prefab",
         Prefab_setup,
         NULL,
-        86,
+        93,
         Prefab_testcases
     },
     {
@@ -9822,7 +10304,7 @@ static bake_test_suite suites[] = {
         "World",
         World_setup,
         NULL,
-        33,
+        40,
         World_testcases
     },
     {
@@ -9843,7 +10325,7 @@ static bake_test_suite suites[] = {
         "MultiThread",
         MultiThread_setup,
         NULL,
-        35,
+        36,
         MultiThread_testcases
     },
     {
@@ -9864,7 +10346,7 @@ static bake_test_suite suites[] = {
         "MultiThreadStaging",
         MultiThreadStaging_setup,
         NULL,
-        10,
+        12,
         MultiThreadStaging_testcases
     },
     {
@@ -9878,7 +10360,7 @@ static bake_test_suite suites[] = {
         "Snapshot",
         NULL,
         NULL,
-        26,
+        28,
         Snapshot_testcases
     },
     {
@@ -9934,5 +10416,5 @@ static bake_test_suite suites[] = {
 
 int main(int argc, char *argv[]) {
     ut_init(argv[0]);
-    return bake_test_run("api", argc, argv, suites, 66);
+    return bake_test_run("api", argc, argv, suites, 67);
 }
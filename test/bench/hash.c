@@ -0,0 +1,85 @@
+/* Benchmark for ecs_hash.
+ * Hashes arrays of ids with the lengths of realistic table types, and compares
+ * against the lookup3 implementation in lookup3.c. See README.md. */
+
+#include "private_api.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TYPE_COUNT (1024)
+#define REPEAT (2000)
+
+void lookup3_hash(
+    const void *data,
+    int32_t length,
+    uint64_t *result);
+
+static
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(void) {
+    ecs_os_set_api_defaults();
+
+    int32_t lengths[] = {4, 8, 16, 32};
+    int32_t l, i, r;
+    uint64_t sum = 0;
+
+    printf("%4s %12s %12s\n", "ids", "lookup3", "ecs_hash");
+
+    for (l = 0; l < 4; l ++) {
+        int32_t length = lengths[l];
+        ecs_id_t *ids = malloc(sizeof(ecs_id_t) * length * TYPE_COUNT);
+
+        /* Types contain sorted component ids, and pairs at the end */
+        for (i = 0; i < TYPE_COUNT; i ++) {
+            ecs_id_t *type = &ids[i * length];
+            int32_t j;
+            for (j = 0; j < length; j ++) {
+                if (j < length - 2) {
+                    type[j] = (ecs_id_t)(j * 7 + i % 13 + 1);
+                } else {
+                    type[j] = ecs_pair(j + 1, (ecs_id_t)(i + 1000));
+                }
+            }
+        }
+
+        double t_lookup3 = 0, t_hash = 0, t;
+        ecs_size_t size = ECS_SIZEOF(ecs_id_t) * length;
+
+        for (r = 0; r < REPEAT; r ++) {
+            t = now();
+            for (i = 0; i < TYPE_COUNT; i ++) {
+                uint64_t h;
+                lookup3_hash(&ids[i * length], size, &h);
+                sum += h;
+            }
+            t_lookup3 += now() - t;
+
+            t = now();
+            for (i = 0; i < TYPE_COUNT; i ++) {
+                uint64_t h;
+                ecs_hash(&ids[i * length], size, &h);
+                sum += h;
+            }
+            t_hash += now() - t;
+        }
+
+        double ops = (double)TYPE_COUNT * REPEAT / 1e9;
+        printf("%4d %9.2f ns %9.2f ns\n", length,
+            t_lookup3 / ops, t_hash / ops);
+
+        free(ids);
+    }
+
+    /* Prevent the compiler from optimizing out the hashes */
+    if (sum == 42) {
+        printf("\n");
+    }
+
+    return 0;
+}
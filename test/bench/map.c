@@ -0,0 +1,143 @@
+/* Benchmark for ecs_map_t.
+ * Only uses the public ecs_map_* API, so the same program can be built against
+ * different revisions of the map to compare them. See README.md. */
+
+#include <flecs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define ELEM_COUNT (1000 * 1000)
+#define REPEAT (5)
+
+typedef struct payload_t {
+    uint64_t value;
+} payload_t;
+
+static
+double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static
+uint64_t next_rand(
+    uint64_t *state)
+{
+    /* splitmix64 */
+    uint64_t z = (*state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static
+void report(
+    const char *name,
+    double t,
+    int32_t count)
+{
+    printf("%-28s %8.2f ns/op\n", name, t * 1e9 / (double)count / REPEAT);
+}
+
+static
+void bench_keys(
+    const char *label,
+    const uint64_t *keys,
+    const uint64_t *missing)
+{
+    char name[64];
+    double t_set = 0, t_get = 0, t_miss = 0, t_iter = 0, t_churn = 0;
+    uint64_t sum = 0;
+    int r, i;
+
+    for (r = 0; r < REPEAT; r ++) {
+        ecs_map_t *map = ecs_map_new(payload_t, 0);
+
+        double t = now();
+        for (i = 0; i < ELEM_COUNT; i ++) {
+            payload_t p = { keys[i] };
+            ecs_map_set(map, keys[i], &p);
+        }
+        t_set += now() - t;
+
+        t = now();
+        for (i = 0; i < ELEM_COUNT; i ++) {
+            payload_t *p = ecs_map_get(map, payload_t, keys[i]);
+            sum += p->value;
+        }
+        t_get += now() - t;
+
+        t = now();
+        for (i = 0; i < ELEM_COUNT; i ++) {
+            sum += ecs_map_get(map, payload_t, missing[i]) != NULL;
+        }
+        t_miss += now() - t;
+
+        t = now();
+        ecs_map_iter_t it = ecs_map_iter(map);
+        payload_t *p;
+        while ((p = ecs_map_next(&it, payload_t, NULL))) {
+            sum += p->value;
+        }
+        t_iter += now() - t;
+
+        /* Remove and reinsert half of the keys */
+        t = now();
+        for (i = 0; i < ELEM_COUNT; i += 2) {
+            ecs_map_remove(map, keys[i]);
+        }
+        for (i = 0; i < ELEM_COUNT; i += 2) {
+            payload_t v = { keys[i] };
+            ecs_map_set(map, keys[i], &v);
+        }
+        t_churn += now() - t;
+
+        ecs_map_free(map);
+    }
+
+    snprintf(name, sizeof(name), "set (%s)", label);
+    report(name, t_set, ELEM_COUNT);
+    snprintf(name, sizeof(name), "get (%s)", label);
+    report(name, t_get, ELEM_COUNT);
+    snprintf(name, sizeof(name), "get missing (%s)", label);
+    report(name, t_miss, ELEM_COUNT);
+    snprintf(name, sizeof(name), "iter (%s)", label);
+    report(name, t_iter, ELEM_COUNT);
+    snprintf(name, sizeof(name), "remove+set (%s)", label);
+    report(name, t_churn, ELEM_COUNT);
+
+    /* Prevent the compiler from optimizing out the lookups */
+    if (sum == 42) {
+        printf("\n");
+    }
+}
+
+int main(void) {
+    ecs_os_set_api_defaults();
+
+    uint64_t *keys = malloc(sizeof(uint64_t) * ELEM_COUNT);
+    uint64_t *missing = malloc(sizeof(uint64_t) * ELEM_COUNT);
+    uint64_t state = 1;
+    int i;
+
+    /* Sequential keys, like entity ids and table ids */
+    for (i = 0; i < ELEM_COUNT; i ++) {
+        keys[i] = (uint64_t)i + 1;
+        missing[i] = (uint64_t)(i + ELEM_COUNT) + 1;
+    }
+    bench_keys("sequential", keys, missing);
+
+    /* Random keys, like pair ids */
+    for (i = 0; i < ELEM_COUNT; i ++) {
+        keys[i] = next_rand(&state) | 1;
+        missing[i] = next_rand(&state) & ~(uint64_t)1;
+    }
+    bench_keys("random", keys, missing);
+
+    free(keys);
+    free(missing);
+
+    return 0;
+}
@@ -284,7 +284,8 @@ void Map_grow() {
         ecs_map_set(map, i, &v);
     }
 
-    test_int(malloc_count, 20);
+    /* Map has room for elements, so no allocations are required */
+    test_int(malloc_count, 0);
 
     ecs_map_free(map);
 }
@@ -309,3 +310,154 @@ void Map_ensure() {
 
     ecs_map_free(map);
 }
+
+void Map_set_get_sequential_keys() {
+    ecs_map_t *map = ecs_map_new(uint64_t, 0);
+
+    uint64_t i, count = 10000;
+    for (i = 0; i < count; i ++) {
+        ecs_map_set(map, i + 1000, &i);
+    }
+
+    test_int(ecs_map_count(map), count);
+
+    for (i = 0; i < count; i ++) {
+        uint64_t *v = ecs_map_get(map, uint64_t, i + 1000);
+        test_assert(v != NULL);
+        test_assert(*v == i);
+    }
+
+    test_assert(ecs_map_get(map, uint64_t, 999) == NULL);
+    test_assert(ecs_map_get(map, uint64_t, count + 1000) == NULL);
+
+    ecs_map_free(map);
+}
+
+void Map_set_get_random_keys() {
+    ecs_map_t *map = ecs_map_new(uint64_t, 0);
+
+    /* Keys with generation & high bits set, like entity ids and pairs */
+    uint64_t key = 1, i, count = 10000;
+    for (i = 0; i < count; i ++) {
+        key = key * 6364136223846793005ull + 1442695040888963407ull;
+        ecs_map_set(map, key, &i);
+    }
+
+    test_int(ecs_map_count(map), count);
+
+    key = 1;
+    for (i = 0; i < count; i ++) {
+        key = key * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t *v = ecs_map_get(map, uint64_t, key);
+        test_assert(v != NULL);
+        test_assert(*v == i);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_remove_reinsert() {
+    ecs_map_t *map = ecs_map_new(uint64_t, 0);
+
+    uint64_t i, count = 1000;
+    for (i = 0; i < count; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    for (i = 0; i < count; i += 2) {
+        ecs_map_remove(map, i);
+    }
+
+    test_int(ecs_map_count(map), count / 2);
+
+    for (i = 0; i < count; i ++) {
+        uint64_t *v = ecs_map_get(map, uint64_t, i);
+        if (i % 2) {
+            test_assert(v != NULL);
+            test_assert(*v == i);
+        } else {
+            test_assert(v == NULL);
+        }
+    }
+
+    for (i = 0; i < count; i += 2) {
+        uint64_t value = i * 2;
+        ecs_map_set(map, i, &value);
+    }
+
+    test_int(ecs_map_count(map), count);
+
+    for (i = 0; i < count; i ++) {
+        uint64_t *v = ecs_map_get(map, uint64_t, i);
+        test_assert(v != NULL);
+        if (i % 2) {
+            test_assert(*v == i);
+        } else {
+            test_assert(*v == i * 2);
+        }
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_remove_reinsert_no_grow() {
+    ecs_map_t *map = ecs_map_new(uint64_t, 0);
+
+    uint64_t i, count = 100;
+    for (i = 0; i < count; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    int32_t bucket_count = ecs_map_bucket_count(map);
+
+    /* Churn should not increase the number of buckets */
+    uint64_t key = count;
+    for (i = 0; i < 100000; i ++) {
+        ecs_map_remove(map, key - count);
+        ecs_map_set(map, key, &key);
+        key ++;
+    }
+
+    test_int(ecs_map_count(map), count);
+    test_int(ecs_map_bucket_count(map), bucket_count);
+
+    for (i = key - count; i < key; i ++) {
+        uint64_t *v = ecs_map_get(map, uint64_t, i);
+        test_assert(v != NULL);
+        test_assert(*v == i);
+    }
+
+    ecs_map_free(map);
+}
+
+void Map_iter_after_remove() {
+    ecs_map_t *map = ecs_map_new(uint64_t, 0);
+
+    uint64_t i, count = 100;
+    for (i = 0; i < count; i ++) {
+        ecs_map_set(map, i, &i);
+    }
+
+    for (i = 0; i < count; i += 3) {
+        ecs_map_remove(map, i);
+    }
+
+    bool found[100] = {false};
+    int32_t found_count = 0;
+
+    ecs_map_iter_t it = ecs_map_iter(map);
+    ecs_map_key_t key;
+    uint64_t *v;
+    while ((v = ecs_map_next(&it, uint64_t, &key))) {
+        test_assert(key < count);
+        test_assert(key % 3 != 0);
+        test_assert(*v == key);
+        test_assert(!found[key]);
+        found[key] = true;
+        found_count ++;
+    }
+
+    test_int(found_count, ecs_map_count(map));
+
+    ecs_map_free(map);
+}
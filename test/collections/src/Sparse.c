@@ -399,3 +399,208 @@ void Sparse_size_of_null() {
 void Sparse_copy_null() {
     test_assert(ecs_sparse_copy(NULL) == NULL);
 }
+
+void Sparse_reserve_vm() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+    test_assert(ecs_sparse_reserve_vm(sp, 10000, false));
+
+    populate(sp, 10000);
+
+    int i;
+    for (i = 0; i < 10000; i ++) {
+        int *ptr = ecs_sparse_get(sp, int, i);
+        test_assert(ptr != NULL);
+        test_int(*ptr, i);
+    }
+
+    uint64_t id = ecs_sparse_ids(sp)[100];
+    test_assert(ecs_sparse_is_alive(sp, id));
+    test_assert(ecs_sparse_get_sparse(sp, int, id) != NULL);
+
+    ecs_sparse_remove(sp, id);
+    test_assert(!ecs_sparse_is_alive(sp, id));
+    test_assert(ecs_sparse_get_sparse(sp, int, id) == NULL);
+    test_int(ecs_sparse_count(sp), 9999);
+
+    ecs_sparse_free(sp);
+}
+
+void Sparse_reserve_vm_outside_range() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+    test_assert(ecs_sparse_reserve_vm(sp, 4096, false));
+
+    int *ptr_1 = ecs_sparse_ensure(sp, int, 100);
+    test_assert(ptr_1 != NULL);
+    *ptr_1 = 10;
+
+    int *ptr_2 = ecs_sparse_ensure(sp, int, 100000);
+    test_assert(ptr_2 != NULL);
+    *ptr_2 = 20;
+
+    test_int(ecs_sparse_count(sp), 2);
+    test_assert(ecs_sparse_get_sparse(sp, int, 100) == ptr_1);
+    test_assert(ecs_sparse_get_sparse(sp, int, 100000) == ptr_2);
+    test_int(*ptr_1, 10);
+    test_int(*ptr_2, 20);
+
+    test_assert(!ecs_sparse_is_alive(sp, 101));
+    test_assert(!ecs_sparse_is_alive(sp, 100001));
+
+    ecs_sparse_free(sp);
+}
+
+void Sparse_reserve_vm_clear() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+    test_assert(ecs_sparse_reserve_vm(sp, 4096, false));
+
+    int *ptr = ecs_sparse_ensure(sp, int, 100);
+    test_assert(ptr != NULL);
+    *ptr = 10;
+
+    ecs_sparse_clear(sp);
+    test_int(ecs_sparse_count(sp), 0);
+    test_assert(!ecs_sparse_is_alive(sp, 100));
+
+    /* Memory of cleared elements must be zero'd */
+    ptr = ecs_sparse_ensure(sp, int, 100);
+    test_assert(ptr != NULL);
+    test_int(*ptr, 0);
+
+    ecs_sparse_free(sp);
+}
+
+void Sparse_compact() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+
+    populate(sp, 10000);
+    test_int(ecs_sparse_count(sp), 10000);
+
+    /* Keep the first 100 elements, which are all in the first chunk */
+    const uint64_t *ids = ecs_sparse_ids(sp);
+    uint64_t *removed = ecs_os_malloc(ECS_SIZEOF(uint64_t) * 9900);
+    ecs_os_memcpy(removed, &ids[100], ECS_SIZEOF(uint64_t) * 9900);
+
+    int i;
+    for (i = 0; i < 9900; i ++) {
+        ecs_sparse_remove(sp, removed[i]);
+    }
+
+    test_int(ecs_sparse_count(sp), 100);
+    test_int(ecs_sparse_size(sp), 10000);
+
+    /* Removed elements in the first chunk can still be recycled */
+    test_assert(ecs_sparse_compact(sp) > 0);
+    test_int(ecs_sparse_count(sp), 100);
+    test_int(ecs_sparse_size(sp), 4096);
+
+    for (i = 0; i < 100; i ++) {
+        int *ptr = ecs_sparse_get(sp, int, i);
+        test_assert(ptr != NULL);
+        test_int(*ptr, i);
+    }
+
+    for (i = 0; i < 9900; i ++) {
+        test_assert(!ecs_sparse_is_alive(sp, removed[i]));
+        test_assert(ecs_sparse_get_sparse(sp, int, removed[i]) == NULL);
+    }
+
+    /* Nothing left to release */
+    test_int(ecs_sparse_compact(sp), 0);
+
+    ecs_os_free(removed);
+    ecs_sparse_free(sp);
+}
+
+void Sparse_compact_add_after() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+
+    populate(sp, 10000);
+
+    uint64_t last = ecs_sparse_last_id(sp);
+    while (ecs_sparse_count(sp)) {
+        ecs_sparse_remove(sp, ecs_sparse_ids(sp)[0]);
+    }
+
+    test_assert(ecs_sparse_compact(sp) > 0);
+    test_int(ecs_sparse_size(sp), 0);
+
+    /* Removed ids in freed chunks are no longer recycled */
+    int *ptr = ecs_sparse_add(sp, int);
+    test_assert(ptr != NULL);
+    test_int(*ptr, 0);
+    test_assert((uint32_t)ecs_sparse_last_id(sp) > last);
+    test_int(ecs_sparse_count(sp), 1);
+
+    /* Removed ids can still be explicitly reused */
+    ptr = ecs_sparse_ensure(sp, int, 10);
+    test_assert(ptr != NULL);
+    test_int(*ptr, 0);
+    test_int(ecs_sparse_count(sp), 2);
+
+    ecs_sparse_free(sp);
+}
+
+void Sparse_compact_recycle() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+
+    populate(sp, 10000);
+
+    /* Remove the first 100 elements, which are all in the first chunk */
+    const uint64_t *ids = ecs_sparse_ids(sp);
+    uint64_t *removed = ecs_os_malloc(ECS_SIZEOF(uint64_t) * 100);
+    ecs_os_memcpy(removed, ids, ECS_SIZEOF(uint64_t) * 100);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_sparse_remove(sp, removed[i]);
+    }
+
+    ecs_sparse_compact(sp);
+    test_int(ecs_sparse_count(sp), 9900);
+    test_int(ecs_sparse_size(sp), 10000);
+
+    /* Removed ids are recycled with a new generation */
+    for (i = 0; i < 100; i ++) {
+        ecs_sparse_add(sp, int);
+        uint64_t id = ecs_sparse_last_id(sp);
+        test_assert((uint32_t)id < 100);
+        test_assert(id != removed[(uint32_t)id]);
+        test_assert(ecs_sparse_is_alive(sp, id));
+        test_assert(!ecs_sparse_is_alive(sp, removed[(uint32_t)id]));
+    }
+
+    test_int(ecs_sparse_count(sp), 10000);
+
+    ecs_os_free(removed);
+    ecs_sparse_free(sp);
+}
+
+void Sparse_compact_vm() {
+    ecs_sparse_t *sp = ecs_sparse_new(int);
+    test_assert(sp != NULL);
+    test_assert(ecs_sparse_reserve_vm(sp, 10000, false));
+
+    populate(sp, 10000);
+
+    while (ecs_sparse_count(sp) > 1) {
+        ecs_sparse_remove(sp, ecs_sparse_ids(sp)[1]);
+    }
+
+    uint64_t id = ecs_sparse_ids(sp)[0];
+    test_assert(ecs_sparse_compact(sp) > 0);
+    test_assert(ecs_sparse_is_alive(sp, id));
+
+    /* Released chunks read as zero when they are used again */
+    int *ptr = ecs_sparse_ensure(sp, int, 9000);
+    test_assert(ptr != NULL);
+    test_int(*ptr, 0);
+    test_assert(ecs_sparse_get_sparse(sp, int, 9000) == ptr);
+
+    ecs_sparse_free(sp);
+}
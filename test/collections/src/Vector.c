@@ -359,3 +359,91 @@ void Vector_set_min_size_to_smaller() {
 
     ecs_vector_free(array);
 }
+
+void Vector_small_vector_add_inline() {
+    ecs_small_vector_t v = {0};
+    test_int(ecs_small_vector_count(&v), 0);
+    test_assert(ecs_small_vector_first(&v) == NULL);
+
+    int i;
+    for (i = 0; i < 8; i ++) {
+        *ecs_small_vector_add(&v, int32_t) = i;
+    }
+
+    /* 8 ints fit in inline storage */
+    test_int(ecs_small_vector_count(&v), 8);
+    test_int(v.size, 0);
+    test_assert(ecs_small_vector_first(&v) == (void*)v.data.inline_data);
+
+    for (i = 0; i < 8; i ++) {
+        test_int(*ecs_small_vector_get(&v, int32_t, i), i);
+    }
+
+    test_assert(ecs_small_vector_get(&v, int32_t, 8) == NULL);
+
+    ecs_small_vector_free(&v);
+}
+
+void Vector_small_vector_add_heap() {
+    ecs_small_vector_t v = {0};
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        *ecs_small_vector_add(&v, int32_t) = i;
+    }
+
+    test_int(ecs_small_vector_count(&v), 100);
+    test_assert(v.size >= 100);
+
+    i = 0;
+    ecs_small_vector_each(&v, int32_t, elem, {
+        test_int(*elem, i);
+        i ++;
+    });
+    test_int(i, 100);
+
+    ecs_small_vector_free(&v);
+    test_int(ecs_small_vector_count(&v), 0);
+    test_int(v.size, 0);
+}
+
+void Vector_small_vector_remove() {
+    ecs_small_vector_t v = {0};
+
+    int i;
+    for (i = 0; i < 4; i ++) {
+        *ecs_small_vector_add(&v, int32_t) = i;
+    }
+
+    /* Last element is moved to removed element */
+    ecs_small_vector_remove(&v, int32_t, 1);
+    test_int(ecs_small_vector_count(&v), 3);
+    test_int(*ecs_small_vector_get(&v, int32_t, 0), 0);
+    test_int(*ecs_small_vector_get(&v, int32_t, 1), 3);
+    test_int(*ecs_small_vector_get(&v, int32_t, 2), 2);
+
+    ecs_small_vector_remove(&v, int32_t, 2);
+    test_int(ecs_small_vector_count(&v), 2);
+    test_int(*ecs_small_vector_get(&v, int32_t, 1), 3);
+
+    ecs_small_vector_free(&v);
+}
+
+void Vector_small_vector_large_elem() {
+    typedef struct { int64_t v[5]; } large_t;
+    ecs_small_vector_t v = {0};
+
+    /* Elements larger than the inline storage go to the heap directly */
+    large_t *elem = ecs_small_vector_add(&v, large_t);
+    test_assert(elem != NULL);
+    test_assert(v.size != 0);
+    elem->v[4] = 10;
+
+    elem = ecs_small_vector_add(&v, large_t);
+    elem->v[4] = 20;
+
+    test_int(ecs_small_vector_get(&v, large_t, 0)->v[4], 10);
+    test_int(ecs_small_vector_get(&v, large_t, 1)->v[4], 20);
+
+    ecs_small_vector_free(&v);
+}
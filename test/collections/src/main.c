@@ -41,6 +41,10 @@ void Vector_addn_to_0_size(void);
 void Vector_set_min_count(void);
 void Vector_set_min_size(void);
 void Vector_set_min_size_to_smaller(void);
+void Vector_small_vector_add_inline(void);
+void Vector_small_vector_add_heap(void);
+void Vector_small_vector_remove(void);
+void Vector_small_vector_large_elem(void);
 
 // Testsuite 'Queue'
 void Queue_setup(void);
@@ -70,6 +74,11 @@ void Map_remove_unknown(void);
 void Map_grow(void);
 void Map_set_size_0(void);
 void Map_ensure(void);
+void Map_set_get_sequential_keys(void);
+void Map_set_get_random_keys(void);
+void Map_remove_reinsert(void);
+void Map_remove_reinsert_no_grow(void);
+void Map_iter_after_remove(void);
 
 // Testsuite 'Sparse'
 void Sparse_setup(void);
@@ -96,6 +105,13 @@ void Sparse_create_delete_2(void);
 void Sparse_count_of_null(void);
 void Sparse_size_of_null(void);
 void Sparse_copy_null(void);
+void Sparse_reserve_vm(void);
+void Sparse_reserve_vm_outside_range(void);
+void Sparse_reserve_vm_clear(void);
+void Sparse_compact(void);
+void Sparse_compact_add_after(void);
+void Sparse_compact_vm(void);
+void Sparse_compact_recycle(void);
 
 // Testsuite 'Strbuf'
 void Strbuf_setup(void);
@@ -238,6 +254,22 @@ bake_test_case Vector_testcases[] = {
     {
         "set_min_size_to_smaller",
         Vector_set_min_size_to_smaller
+    },
+    {
+        "small_vector_add_inline",
+        Vector_small_vector_add_inline
+    },
+    {
+        "small_vector_add_heap",
+        Vector_small_vector_add_heap
+    },
+    {
+        "small_vector_remove",
+        Vector_small_vector_remove
+    },
+    {
+        "small_vector_large_elem",
+        Vector_small_vector_large_elem
     }
 };
 
@@ -336,6 +368,26 @@ bake_test_case Map_testcases[] = {
     {
         "ensure",
         Map_ensure
+    },
+    {
+        "set_get_sequential_keys",
+        Map_set_get_sequential_keys
+    },
+    {
+        "set_get_random_keys",
+        Map_set_get_random_keys
+    },
+    {
+        "remove_reinsert",
+        Map_remove_reinsert
+    },
+    {
+        "remove_reinsert_no_grow",
+        Map_remove_reinsert_no_grow
+    },
+    {
+        "iter_after_remove",
+        Map_iter_after_remove
     }
 };
 
@@ -431,6 +483,34 @@ bake_test_case Sparse_testcases[] = {
     {
         "copy_null",
         Sparse_copy_null
+    },
+    {
+        "reserve_vm",
+        Sparse_reserve_vm
+    },
+    {
+        "reserve_vm_outside_range",
+        Sparse_reserve_vm_outside_range
+    },
+    {
+        "reserve_vm_clear",
+        Sparse_reserve_vm_clear
+    },
+    {
+        "compact",
+        Sparse_compact
+    },
+    {
+        "compact_add_after",
+        Sparse_compact_add_after
+    },
+    {
+        "compact_vm",
+        Sparse_compact_vm
+    },
+    {
+        "compact_recycle",
+        Sparse_compact_recycle
     }
 };
 
@@ -498,7 +578,7 @@ static bake_test_suite suites[] = {
         "Vector",
         Vector_setup,
         NULL,
-        31,
+        35,
         Vector_testcases
     },
     {
@@ -512,14 +592,14 @@ static bake_test_suite suites[] = {
         "Map",
         Map_setup,
         NULL,
-        19,
+        24,
         Map_testcases
     },
     {
         "Sparse",
         Sparse_setup,
         NULL,
-        23,
+        30,
         Sparse_testcases
     },
     {
@@ -768,3 +768,23 @@ void World_template_component_w_same_namespace_name_and_namespaced_arg() {
     test_str(c.name().c_str(), "foo<foo::bar>");
     test_str(c.path().c_str(), "::foo::foo<foo::bar>");
 }
+
+void World_get_many() {
+    flecs::world ecs;
+
+    flecs::entity_t entities[3];
+    entities[0] = ecs.entity().set<Position>({10, 20});
+    entities[1] = ecs.entity().set<Velocity>({1, 2});
+    entities[2] = ecs.entity().set<Position>({30, 40});
+
+    const Position *ptrs[3];
+    ecs.get_many<Position>(entities, 3, ptrs);
+
+    test_assert(ptrs[0] != nullptr);
+    test_int(ptrs[0]->x, 10);
+    test_int(ptrs[0]->y, 20);
+    test_assert(ptrs[1] == nullptr);
+    test_assert(ptrs[2] != nullptr);
+    test_int(ptrs[2]->x, 30);
+    test_int(ptrs[2]->y, 40);
+}
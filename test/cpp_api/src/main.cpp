@@ -578,6 +578,7 @@ void World_template_component_w_namespace_name(void);
 void World_template_component_w_same_namespace_name(void);
 void World_template_component_w_namespace_name_and_namespaced_arg(void);
 void World_template_component_w_same_namespace_name_and_namespaced_arg(void);
+void World_get_many(void);
 
 // Testsuite 'Singleton'
 void Singleton_set_get_singleton(void);
@@ -2794,6 +2795,10 @@ bake_test_case World_testcases[] = {
     {
         "template_component_w_same_namespace_name_and_namespaced_arg",
         World_template_component_w_same_namespace_name_and_namespaced_arg
+    },
+    {
+        "get_many",
+        World_get_many
     }
 };
 
@@ -3003,7 +3008,7 @@ static bake_test_suite suites[] = {
         "World",
         NULL,
         NULL,
-        38,
+        39,
         World_testcases
     },
     {